@@ -5,34 +5,276 @@
 #include <algorithm>
 #include <stdexcept>
 #include <limits>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <cstdlib>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FW_X86_KERNELS 1
+#include <immintrin.h>
+#endif
 using namespace std;
 
 const double INF = numeric_limits<double>::infinity();
 
+// -- Min-plus row kernels ---------------------------------------------------
+// minPlusRow is the inner loop of Floyd-Warshall for one row of one tile:
+//   c[j] = min(c[j], aik + b[j]), and where c[j] improved, nc[j] = nik.
+// minPlusRowBlock applies that for all kTile values of k in a k-block, with
+// a[k] / na[k] the row's entries in the k-block and b the k-block's rows
+// (bStride apart). It keeps a chunk of c in registers across all k, so only
+// b is loaded per step; a must not alias c.
+// Branch-free: the comparison yields a lane mask that blends both the new
+// distances and the next hops. INF needs no special case, since INF + x is
+// INF and never compares less. On x86 the AVX2 and AVX-512 kernels are
+// always compiled (per-function target attributes, no -m flags needed) and
+// minPlusKernel() picks the widest one the running CPU supports; elsewhere
+// the scalar loops are used.
+constexpr int kTile = 64;                 // tile edge, a multiple of 32
+
+void minPlusRowScalar(double* c, int* nc, double aik, int nik, const double* b) {
+    for (int j = 0; j < kTile; j++) {
+        double t = aik + b[j];
+        bool better = t < c[j];
+        c[j]  = better ? t : c[j];
+        nc[j] = better ? nik : nc[j];
+    }
+}
+
+// Without SIMD registers to hold c, this is minPlusRow per k; the
+// compiler's own vectorizer does better on that single-row loop
+void minPlusRowBlockScalar(double* c, int* nc, const double* a, const int* na,
+                           const double* b, size_t bStride) {
+    for (int k = 0; k < kTile; k++) minPlusRowScalar(c, nc, a[k], na[k], b + k * bStride);
+}
+
+#ifdef FW_X86_KERNELS
+__attribute__((target("avx512f,avx512vl")))
+void minPlusRowAvx512(double* c, int* nc, double aik, int nik, const double* b) {
+    __m512d a  = _mm512_set1_pd(aik);
+    __m256i nk = _mm256_set1_epi32(nik);
+    for (int j = 0; j < kTile; j += 8) {
+        __m512d cur = _mm512_loadu_pd(c + j);
+        __m512d t   = _mm512_add_pd(a, _mm512_loadu_pd(b + j));
+        __mmask8 better = _mm512_cmp_pd_mask(t, cur, _CMP_LT_OQ);
+        _mm512_storeu_pd(c + j, _mm512_mask_blend_pd(better, cur, t));
+        __m256i nx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nc + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(nc + j), _mm256_mask_blend_epi32(better, nx, nk));
+    }
+}
+
+__attribute__((target("avx512f,avx512vl")))
+void minPlusRowBlockAvx512(double* c, int* nc, const double* a, const int* na,
+                           const double* b, size_t bStride) {
+    for (int j = 0; j < kTile; j += 32) {
+        __m512d c0 = _mm512_loadu_pd(c + j),      c1 = _mm512_loadu_pd(c + j + 8);
+        __m512d c2 = _mm512_loadu_pd(c + j + 16), c3 = _mm512_loadu_pd(c + j + 24);
+        __m256i n0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nc + j));
+        __m256i n1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nc + j + 8));
+        __m256i n2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nc + j + 16));
+        __m256i n3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nc + j + 24));
+        for (int k = 0; k < kTile; k++) {
+            __m512d ak = _mm512_set1_pd(a[k]);
+            __m256i nk = _mm256_set1_epi32(na[k]);
+            const double* bk = b + k * bStride + j;
+            __m512d t0 = _mm512_add_pd(ak, _mm512_loadu_pd(bk));
+            __m512d t1 = _mm512_add_pd(ak, _mm512_loadu_pd(bk + 8));
+            __m512d t2 = _mm512_add_pd(ak, _mm512_loadu_pd(bk + 16));
+            __m512d t3 = _mm512_add_pd(ak, _mm512_loadu_pd(bk + 24));
+            __mmask8 m0 = _mm512_cmp_pd_mask(t0, c0, _CMP_LT_OQ);
+            __mmask8 m1 = _mm512_cmp_pd_mask(t1, c1, _CMP_LT_OQ);
+            __mmask8 m2 = _mm512_cmp_pd_mask(t2, c2, _CMP_LT_OQ);
+            __mmask8 m3 = _mm512_cmp_pd_mask(t3, c3, _CMP_LT_OQ);
+            c0 = _mm512_mask_blend_pd(m0, c0, t0); n0 = _mm256_mask_blend_epi32(m0, n0, nk);
+            c1 = _mm512_mask_blend_pd(m1, c1, t1); n1 = _mm256_mask_blend_epi32(m1, n1, nk);
+            c2 = _mm512_mask_blend_pd(m2, c2, t2); n2 = _mm256_mask_blend_epi32(m2, n2, nk);
+            c3 = _mm512_mask_blend_pd(m3, c3, t3); n3 = _mm256_mask_blend_epi32(m3, n3, nk);
+        }
+        _mm512_storeu_pd(c + j, c0);      _mm512_storeu_pd(c + j + 8, c1);
+        _mm512_storeu_pd(c + j + 16, c2); _mm512_storeu_pd(c + j + 24, c3);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(nc + j), n0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(nc + j + 8), n1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(nc + j + 16), n2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(nc + j + 24), n3);
+    }
+}
+
+__attribute__((target("avx2")))
+void minPlusRowAvx2(double* c, int* nc, double aik, int nik, const double* b) {
+    __m256d a  = _mm256_set1_pd(aik);
+    __m128i nk = _mm_set1_epi32(nik);
+    // Picks the low half of each 64-bit mask lane to get 32-bit lanes
+    const __m256i narrow = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    for (int j = 0; j < kTile; j += 4) {
+        __m256d cur = _mm256_loadu_pd(c + j);
+        __m256d t   = _mm256_add_pd(a, _mm256_loadu_pd(b + j));
+        __m256d better = _mm256_cmp_pd(t, cur, _CMP_LT_OQ);
+        _mm256_storeu_pd(c + j, _mm256_blendv_pd(cur, t, better));
+        __m128i mask = _mm256_castsi256_si128(
+            _mm256_permutevar8x32_epi32(_mm256_castpd_si256(better), narrow));
+        __m128i nx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nc + j));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(nc + j), _mm_blendv_epi8(nx, nk, mask));
+    }
+}
+
+// Next hops where better (a 4 x 64-bit lane mask) is set, nk elsewhere nx.
+// A plain function rather than a lambda: lambdas do not inherit the
+// enclosing function's target attribute.
+__attribute__((target("avx2")))
+inline __m128i blendNextAvx2(__m128i nx, __m128i nk, __m256d better) {
+    const __m256i narrow = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    __m128i mask = _mm256_castsi256_si128(
+        _mm256_permutevar8x32_epi32(_mm256_castpd_si256(better), narrow));
+    return _mm_blendv_epi8(nx, nk, mask);
+}
+
+__attribute__((target("avx2")))
+void minPlusRowBlockAvx2(double* c, int* nc, const double* a, const int* na,
+                         const double* b, size_t bStride) {
+    for (int j = 0; j < kTile; j += 16) {
+        __m256d c0 = _mm256_loadu_pd(c + j),     c1 = _mm256_loadu_pd(c + j + 4);
+        __m256d c2 = _mm256_loadu_pd(c + j + 8), c3 = _mm256_loadu_pd(c + j + 12);
+        __m128i n0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nc + j));
+        __m128i n1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nc + j + 4));
+        __m128i n2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nc + j + 8));
+        __m128i n3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nc + j + 12));
+        for (int k = 0; k < kTile; k++) {
+            __m256d ak = _mm256_set1_pd(a[k]);
+            __m128i nk = _mm_set1_epi32(na[k]);
+            const double* bk = b + k * bStride + j;
+            __m256d t0 = _mm256_add_pd(ak, _mm256_loadu_pd(bk));
+            __m256d t1 = _mm256_add_pd(ak, _mm256_loadu_pd(bk + 4));
+            __m256d t2 = _mm256_add_pd(ak, _mm256_loadu_pd(bk + 8));
+            __m256d t3 = _mm256_add_pd(ak, _mm256_loadu_pd(bk + 12));
+            n0 = blendNextAvx2(n0, nk, _mm256_cmp_pd(t0, c0, _CMP_LT_OQ));
+            n1 = blendNextAvx2(n1, nk, _mm256_cmp_pd(t1, c1, _CMP_LT_OQ));
+            n2 = blendNextAvx2(n2, nk, _mm256_cmp_pd(t2, c2, _CMP_LT_OQ));
+            n3 = blendNextAvx2(n3, nk, _mm256_cmp_pd(t3, c3, _CMP_LT_OQ));
+            c0 = _mm256_min_pd(t0, c0); c1 = _mm256_min_pd(t1, c1);   // t < c ? t : c
+            c2 = _mm256_min_pd(t2, c2); c3 = _mm256_min_pd(t3, c3);
+        }
+        _mm256_storeu_pd(c + j, c0);     _mm256_storeu_pd(c + j + 4, c1);
+        _mm256_storeu_pd(c + j + 8, c2); _mm256_storeu_pd(c + j + 12, c3);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(nc + j), n0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(nc + j + 4), n1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(nc + j + 8), n2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(nc + j + 12), n3);
+    }
+}
+#endif
+
+// The kernels solveBlocked() runs, chosen once for the running CPU
+struct MinPlusKernel {
+    const char* isa;
+    void (*row)(double* c, int* nc, double aik, int nik, const double* b);
+    void (*rowBlock)(double* c, int* nc, const double* a, const int* na,
+                     const double* b, size_t bStride);
+};
+
+const MinPlusKernel& minPlusKernel() {
+    static const MinPlusKernel kernel = [] {
+#ifdef FW_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl"))
+            return MinPlusKernel{"AVX-512", minPlusRowAvx512, minPlusRowBlockAvx512};
+        if (__builtin_cpu_supports("avx2"))
+            return MinPlusKernel{"AVX2", minPlusRowAvx2, minPlusRowBlockAvx2};
+#endif
+        return MinPlusKernel{"scalar", minPlusRowScalar, minPlusRowBlockScalar};
+    }();
+    return kernel;
+}
+
+// Run fn(task) for every task in [0, count), handed out to up to `threads`
+// threads through a shared counter
+template<typename F>
+void parallelFor(int threads, int count, F&& fn) {
+    if (threads <= 1 || count <= 1) { for (int t = 0; t < count; t++) fn(t); return; }
+    atomic<int> nextTask(0);
+    auto worker = [&] { for (int t; (t = nextTask.fetch_add(1)) < count;) fn(t); };
+    vector<thread> pool;
+    for (int i = 1; i < min(threads, count); i++) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
 // -- Floyd-Warshall ---------------------------------------------------------
+// dist and next are single row-major arrays. Rows are padded to a whole
+// number of kTile-wide tiles; the padding is INF / -1, so it never offers
+// a shorter path and the tiled solver needs no edge cases.
 class FloydWarshall {
 private:
     int              n;
+    int              stride;       // row length, n rounded up to a tile
     vector<string>   labels;
-    vector<vector<double>> dist;   // shortest distances
-    vector<vector<int>>    next;   // next-hop for path reconstruction
+    vector<double>   dist;         // shortest distances
+    vector<int>      next;         // next-hop for path reconstruction
+
+    double& D(int i, int j)       { return dist[(size_t)i * stride + j]; }
+    double  D(int i, int j) const { return dist[(size_t)i * stride + j]; }
+    int&    N(int i, int j)       { return next[(size_t)i * stride + j]; }
+    int     N(int i, int j) const { return next[(size_t)i * stride + j]; }
+
+    // Relax tile (ib, jb) through the vertices of k-block kb, k outermost.
+    // Needed when the tile shares rows with the k-block (ib == kb), where
+    // later k steps must see the rows that earlier ones updated.
+    void relaxTileKOuter(int ib, int jb, int kb) {
+        auto minPlusRow = minPlusKernel().row;
+        for (int k = kb * kTile; k < (kb + 1) * kTile; k++) {
+            const double* bRow = &D(k, jb * kTile);
+            for (int i = ib * kTile; i < (ib + 1) * kTile; i++) {
+                double aik = D(i, k);
+                if (aik == INF) continue;
+                minPlusRow(&D(i, jb * kTile), &N(i, jb * kTile), aik, N(i, k), bRow);
+            }
+        }
+    }
+
+    // Phase 3 tile: its row slice of column block kb and the k-block's rows
+    // are both final, so each row takes the whole k-block in one
+    // register-blocked minPlusRowBlock call
+    void relaxTileThroughBlock(int ib, int jb, int kb) {
+        auto minPlusRowBlock = minPlusKernel().rowBlock;
+        const double* b = &D(kb * kTile, jb * kTile);
+        for (int i = ib * kTile; i < (ib + 1) * kTile; i++)
+            minPlusRowBlock(&D(i, jb * kTile), &N(i, jb * kTile), &D(i, kb * kTile), &N(i, kb * kTile),
+                            b, stride);
+    }
+
+    // Same relaxation, i outermost, for a tile of column block kb: row i's
+    // slice of the k-block is the row being updated, so each k step must see
+    // the previous ones.
+    void relaxTileIOuter(int ib, int jb, int kb) {
+        auto minPlusRow = minPlusKernel().row;
+        for (int i = ib * kTile; i < (ib + 1) * kTile; i++) {
+            double* cRow = &D(i, jb * kTile);
+            int*    nRow = &N(i, jb * kTile);
+            for (int k = kb * kTile; k < (kb + 1) * kTile; k++) {
+                double aik = D(i, k);
+                if (aik == INF) continue;
+                minPlusRow(cRow, nRow, aik, N(i, k), &D(k, jb * kTile));
+            }
+        }
+    }
 
 public:
     explicit FloydWarshall(int vertices, vector<string> lbls = {})
-        : n(vertices), labels(lbls),
-          dist(vertices, vector<double>(vertices, INF)),
-          next(vertices, vector<int>(vertices, -1))
+        : n(vertices), stride((vertices + kTile - 1) / kTile * kTile), labels(lbls),
+          dist((size_t)stride * stride, INF),
+          next((size_t)stride * stride, -1)
     {
         if (labels.empty()) for (int i = 0; i < n; i++) labels.push_back(to_string(i));
-        for (int i = 0; i < n; i++) { dist[i][i] = 0; next[i][i] = i; }
+        for (int i = 0; i < n; i++) { D(i, i) = 0; N(i, i) = i; }
     }
 
     // Add a directed edge (use twice for undirected)
     void addEdge(int u, int v, double w) {
         if (u < 0 || u >= n || v < 0 || v >= n) throw out_of_range("Vertex out of range.");
-        if (w < dist[u][v]) {           // keep lightest parallel edge
-            dist[u][v] = w;
-            next[u][v] = v;
+        if (w < D(u, v)) {              // keep lightest parallel edge
+            D(u, v) = w;
+            N(u, v) = v;
         }
     }
 
@@ -45,33 +287,63 @@ public:
     void solve() {
         for (int k = 0; k < n; k++) {
             for (int i = 0; i < n; i++) {
-                if (dist[i][k] == INF) continue;
+                if (D(i, k) == INF) continue;
                 for (int j = 0; j < n; j++) {
-                    if (dist[k][j] == INF) continue;
-                    double through = dist[i][k] + dist[k][j];
-                    if (through < dist[i][j]) {
-                        dist[i][j] = through;
-                        next[i][j] = next[i][k];
+                    if (D(k, j) == INF) continue;
+                    double through = D(i, k) + D(k, j);
+                    if (through < D(i, j)) {
+                        D(i, j) = through;
+                        N(i, j) = N(i, k);
                     }
                 }
             }
         }
     }
 
+    // Blocked Floyd-Warshall (Venkataraman et al.), same O(V^3) work in
+    // kTile x kTile tiles that stay in cache. For each k-block kb:
+    //   1. the diagonal tile (kb, kb) runs plain Floyd-Warshall on itself;
+    //   2. the other tiles of row kb and column kb relax through it, all
+    //      independent of each other;
+    //   3. every remaining tile (i, j) relaxes through (i, kb) and (kb, j),
+    //      again all independent.
+    // Phases 2 and 3 are spread across threads. Same distances as solve()
+    // (exactly, for integer weights); with ties, next hops may pick a
+    // different but equally short path.
+    void solveBlocked(int threads = 0) {
+        if (threads <= 0) threads = max(1, (int)thread::hardware_concurrency());
+        const int tiles = stride / kTile, others = tiles - 1;
+        for (int kb = 0; kb < tiles; kb++) {
+            relaxTileKOuter(kb, kb, kb);
+            parallelFor(threads, 2 * others, [&](int t) {
+                int other = t % others;
+                if (other >= kb) other++;
+                if (t < others) relaxTileKOuter(kb, other, kb);   // row kb
+                else            relaxTileIOuter(other, kb, kb);   // column kb
+            });
+            parallelFor(threads, others * others, [&](int t) {
+                int ib = t / others, jb = t % others;
+                if (ib >= kb) ib++;
+                if (jb >= kb) jb++;
+                relaxTileThroughBlock(ib, jb, kb);
+            });
+        }
+    }
+
     // Detect negative cycles (dist[i][i] < 0 after solve)
     bool hasNegativeCycle() const {
-        for (int i = 0; i < n; i++) if (dist[i][i] < 0) return true;
+        for (int i = 0; i < n; i++) if (D(i, i) < 0) return true;
         return false;
     }
 
     // Get shortest distance between two nodes
-    double getDistance(int u, int v) const { return dist[u][v]; }
+    double getDistance(int u, int v) const { return D(u, v); }
 
     // Reconstruct path from u to v
     vector<int> getPath(int u, int v) const {
-        if (dist[u][v] == INF) return {};
+        if (D(u, v) == INF) return {};
         vector<int> path;
-        for (int cur = u; cur != v; cur = next[cur][v]) {
+        for (int cur = u; cur != v; cur = N(cur, v)) {
             if (cur == -1) return {};
             path.push_back(cur);
         }
@@ -81,13 +353,13 @@ public:
 
     void printPath(int u, int v) const {
         cout << labels[u] << " -> " << labels[v] << ": ";
-        if (dist[u][v] == INF) { cout << "UNREACHABLE\n"; return; }
+        if (D(u, v) == INF) { cout << "UNREACHABLE\n"; return; }
         auto path = getPath(u, v);
         for (size_t i = 0; i < path.size(); i++) {
             cout << labels[path[i]];
             if (i+1 < path.size()) cout << " -> ";
         }
-        cout << "  (cost=" << fixed << setprecision(1) << dist[u][v] << ")\n";
+        cout << "  (cost=" << fixed << setprecision(1) << D(u, v) << ")\n";
     }
 
     // Print full distance matrix
@@ -99,8 +371,8 @@ public:
         for (int i = 0; i < n; i++) {
             cout << setw(W) << labels[i];
             for (int j = 0; j < n; j++) {
-                if (dist[i][j] == INF) cout << setw(W) << "INF";
-                else cout << setw(W) << fixed << setprecision(1) << dist[i][j];
+                if (D(i, j) == INF) cout << setw(W) << "INF";
+                else cout << setw(W) << fixed << setprecision(1) << D(i, j);
             }
             cout << "\n";
         }
@@ -115,8 +387,8 @@ public:
         for (int i = 0; i < n; i++) {
             cout << setw(W) << labels[i];
             for (int j = 0; j < n; j++) {
-                if (next[i][j] == -1) cout << setw(W) << "-";
-                else cout << setw(W) << labels[next[i][j]];
+                if (N(i, j) == -1) cout << setw(W) << "-";
+                else cout << setw(W) << labels[N(i, j)];
             }
             cout << "\n";
         }
@@ -127,7 +399,7 @@ public:
         double d = 0;
         for (int i = 0; i < n; i++)
             for (int j = 0; j < n; j++)
-                if (dist[i][j] != INF && dist[i][j] > d) d = dist[i][j];
+                if (D(i, j) != INF && D(i, j) > d) d = D(i, j);
         return d;
     }
 
@@ -136,7 +408,7 @@ public:
         vector<double> ecc(n, 0);
         for (int i = 0; i < n; i++)
             for (int j = 0; j < n; j++)
-                if (dist[i][j] != INF) ecc[i] = max(ecc[i], dist[i][j]);
+                if (D(i, j) != INF) ecc[i] = max(ecc[i], D(i, j));
         double minEcc = *min_element(ecc.begin(), ecc.end());
         vector<int> centers;
         for (int i = 0; i < n; i++) if (ecc[i] == minEcc) centers.push_back(i);
@@ -148,7 +420,7 @@ public:
         vector<vector<bool>> reach(n, vector<bool>(n, false));
         for (int i = 0; i < n; i++)
             for (int j = 0; j < n; j++)
-                if (dist[i][j] != INF) reach[i][j] = true;
+                if (D(i, j) != INF) reach[i][j] = true;
         return reach;
     }
 
@@ -160,7 +432,77 @@ void sep(const string& t) {
     cout << "\n" << string(60, '=') << "\n " << t << "\n" << string(60, '=') << "\n";
 }
 
-int main() {
+double timeMs(const function<void()>& fn) {
+    auto start = chrono::steady_clock::now();
+    fn();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// solve() vs solveBlocked() on random graphs with 16 out-edges per vertex.
+// Weights are integers, so every solver must give bit-identical distances;
+// the textbook loop only runs up to textbookMaxN. Paths are checked by
+// summing the original edge weights along getPath() for sampled pairs.
+void benchmarkFloydWarshall(int maxN, int textbookMaxN) {
+    cout << "min-plus kernel: " << minPlusKernel().isa << ", tile " << kTile
+         << ", hardware threads: " << thread::hardware_concurrency() << "\n\n";
+    cout << setw(6) << "n" << setw(12) << "solve() s" << setw(15) << "blocked x1 s"
+         << setw(15) << "blocked x4 s" << setw(12) << "Gupdates/s" << setw(10) << "speedup" << "  check\n";
+    for (int n = 1024; n <= maxN; n *= 2) {
+        FloydWarshall edges(n);
+        mt19937 rng(n);
+        uniform_int_distribution<int> vertex(0, n - 1), weight(1, 100);
+        for (int u = 0; u < n; u++)
+            for (int e = 0; e < 16; e++) edges.addEdge(u, vertex(rng), weight(rng));
+
+        FloydWarshall blocked = edges;
+        double blockedS = timeMs([&] { blocked.solveBlocked(1); }) / 1e3;
+        bool ok = true;
+        auto sameAs = [&](const FloydWarshall& other) {
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++)
+                    if (other.getDistance(i, j) != blocked.getDistance(i, j)) return false;
+            return true;
+        };
+        double parallelS;
+        {
+            FloydWarshall parallel = edges;
+            parallelS = timeMs([&] { parallel.solveBlocked(4); }) / 1e3;
+            ok = ok && sameAs(parallel);
+        }
+        double textbookS = 0;
+        if (n <= textbookMaxN) {
+            FloydWarshall textbook = edges;
+            textbookS = timeMs([&] { textbook.solve(); }) / 1e3;
+            ok = ok && sameAs(textbook);
+        }
+        for (int s = 0; s < 2000 && ok; s++) {
+            int a = vertex(rng), b = vertex(rng);
+            auto path = blocked.getPath(a, b);
+            double sum = 0;
+            for (size_t i = 0; i + 1 < path.size(); i++) sum += edges.getDistance(path[i], path[i + 1]);
+            ok = blocked.getDistance(a, b) == INF ? path.empty() : !path.empty() && sum == blocked.getDistance(a, b);
+        }
+
+        cout << setw(6) << n << fixed << setprecision(2);
+        if (n <= textbookMaxN) cout << setw(12) << textbookS;
+        else                   cout << setw(12) << "-";
+        cout << setw(15) << blockedS << setw(15) << parallelS
+             << setw(12) << (double)n * n * n / blockedS / 1e9;
+        if (n <= textbookMaxN) cout << setw(9) << textbookS / blockedS << "x";
+        else                   cout << setw(10) << "-";
+        cout << "  " << (ok ? "ok" : "MISMATCH") << "\n";
+    }
+}
+
+// Usage: ./Floyd-Warshall [maxN]
+// maxN is the largest benchmark size (default 2048); sizes double from 1024,
+// so 8192 gives 1k, 2k, 4k and 8k. The textbook solver stops at 1024.
+int main(int argc, char** argv) {
+    int benchMaxN = 2048;
+    if (argc > 1) {
+        benchMaxN = atoi(argv[1]);
+        if (benchMaxN < 1024) { cerr << "maxN must be at least 1024\n"; return 1; }
+    }
     cout << "=== Floyd-Warshall All-Pairs Shortest Path ===\n";
 
     // -- Demo 1: Simple directed graph -------------------------------------
@@ -254,5 +596,26 @@ int main() {
     cout << "\nA->C: "; fw6.printPath(0,2);
     cout << "A->D: "; fw6.printPath(0,3);
 
+    // -- Demo 7: Blocked SIMD solver ----------------------------------------
+    sep("7. Blocked, Vectorized, Multi-threaded Solver");
+    FloydWarshall fw7(4, {"A","B","C","D"});
+    fw7.addEdge(0,1,3); fw7.addEdge(0,3,7);
+    fw7.addEdge(1,0,8); fw7.addEdge(1,2,2);
+    fw7.addEdge(2,0,5); fw7.addEdge(2,3,1);
+    fw7.addEdge(3,0,2);
+    fw7.solveBlocked(4);
+    cout << "Same graph as demo 1, solveBlocked(4):\n\n";
+    fw7.printDistMatrix();
+    cout << "\n";
+    for (int j = 1; j < 4; j++) fw7.printPath(0, j);
+    FloydWarshall fw8(3, {"X","Y","Z"});
+    fw8.addEdge(0,1,4); fw8.addEdge(1,2,-6); fw8.addEdge(2,0,1);
+    fw8.solveBlocked();
+    cout << "Negative cycle of demo 4 detected: " << (fw8.hasNegativeCycle() ? "YES" : "NO") << "\n";
+
+    // -- Demo 8: Benchmark ------------------------------------------------
+    sep("8. Benchmark: textbook vs blocked");
+    benchmarkFloydWarshall(benchMaxN, 1024);
+
     return 0;
 }
\ No newline at end of file
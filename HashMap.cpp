@@ -1,18 +1,207 @@
 #include <iostream>
 #include <vector>
-#include <list>
 #include <string>
 #include <functional>
 #include <stdexcept>
 #include <iomanip>
 #include <algorithm>
 #include <numeric>
+#include <cstring>
+#include <type_traits>
+#include <memory>
+#include <cstdint>
+#include <chrono>
+#include <unordered_map>
+#include <utility>
+#include <string_view>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <fstream>
+#include <filesystem>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
+// -- Storage policies -------------------------------------------------------
+struct Chaining {};        // segmented bucket heads, one singly-linked heap node per entry
+struct OpenAddressing {};  // Swiss table: flat slots + SIMD control-byte groups
+
+// -- Slab allocator ---------------------------------------------------------
+// Small fixed-size objects (chain nodes) are carved out of large blocks, one
+// free list per 8-byte size class, and recycled on deallocate. Bulk arrays,
+// oversized or over-aligned objects go straight to operator new. Not
+// thread-safe: allocators copied or rebound from one another share an arena
+// and its non-atomic reference count. A container copy asks for a fresh
+// allocator (select_on_container_copy_construction), so a copied HashMap
+// gets its own arena and no arena is shared between maps unless the caller
+// passes the same allocator to both.
+class SlabArena {
+    template<typename T> friend class SlabAllocator;
+    size_t refs = 1;
+
+public:
+    static constexpr size_t kAlign       = alignof(void*);
+    static constexpr size_t kMaxSmall    = 256;
+    static constexpr size_t kClasses     = kMaxSmall / kAlign;
+    static constexpr size_t kMaxPerBlock = 16384;
+
+    SlabArena() = default;
+    SlabArena(const SlabArena&) = delete;
+    SlabArena& operator=(const SlabArena&) = delete;
+    ~SlabArena() { for (void* b : blocks) ::operator delete(b); }
+
+    void* allocate(size_t bytes) {
+        if (bytes > kMaxSmall) return ::operator new(bytes);
+        SizeClass& c = classes[(bytes + kAlign - 1) / kAlign - 1];
+        if (!c.freeList) refill(c, (bytes + kAlign - 1) / kAlign * kAlign);
+        FreeNode* n = c.freeList;
+        c.freeList = n->next;
+        live += bytes;
+        return n;
+    }
+
+    void deallocate(void* p, size_t bytes) {
+        if (bytes > kMaxSmall) { ::operator delete(p); return; }
+        SizeClass& c = classes[(bytes + kAlign - 1) / kAlign - 1];
+        auto* n = static_cast<FreeNode*>(p);
+        n->next    = c.freeList;
+        c.freeList = n;
+        live -= bytes;
+    }
+
+    size_t reservedBytes() const { return reserved; }   // all slab blocks
+    size_t liveBytes()     const { return live; }       // requested by live objects
+
+private:
+    struct FreeNode { FreeNode* next; };
+    struct SizeClass {
+        FreeNode* freeList  = nullptr;
+        size_t    slotSize  = 0;
+        size_t    nextBlock = 16;     // slots in the next block, doubles up to kMaxPerBlock
+    };
+
+    SizeClass     classes[kClasses];
+    vector<void*> blocks;
+    size_t        reserved = 0;
+    size_t        live     = 0;
+
+    void refill(SizeClass& c, size_t slotSize) {
+        c.slotSize = slotSize;
+        size_t count = c.nextBlock;
+        c.nextBlock  = min(c.nextBlock * 2, kMaxPerBlock);
+        char* block  = static_cast<char*>(::operator new(count * slotSize));
+        blocks.push_back(block);
+        reserved += count * slotSize;
+        for (size_t i = count; i-- > 0; ) {
+            auto* n = reinterpret_cast<FreeNode*>(block + i * slotSize);
+            n->next    = c.freeList;
+            c.freeList = n;
+        }
+    }
+};
+
+template<typename T>
+class SlabAllocator {
+    template<typename U> friend class SlabAllocator;
+    SlabArena* arena;
+
+    static constexpr bool kSlab = alignof(T) <= SlabArena::kAlign;
+
+    void release() { if (--arena->refs == 0) delete arena; }
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = true_type;
+    using propagate_on_container_move_assignment = true_type;
+    using propagate_on_container_swap            = true_type;
+
+    SlabAllocator() : arena(new SlabArena) {}
+    SlabAllocator(const SlabAllocator& other) noexcept : arena(other.arena) { arena->refs++; }
+    template<typename U>
+    SlabAllocator(const SlabAllocator<U>& other) noexcept : arena(other.arena) { arena->refs++; }
+    ~SlabAllocator() { release(); }
+
+    SlabAllocator& operator=(const SlabAllocator& other) noexcept {
+        other.arena->refs++;
+        release();
+        arena = other.arena;
+        return *this;
+    }
+
+    T* allocate(size_t n) {
+        if (n == 1 && kSlab) return static_cast<T*>(arena->allocate(sizeof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (n == 1 && kSlab) arena->deallocate(p, sizeof(T));
+        else ::operator delete(p);
+    }
+
+    // Copied containers start a new arena instead of sharing this one
+    SlabAllocator select_on_container_copy_construction() const { return SlabAllocator(); }
+
+    const SlabArena& stats() const { return *arena; }
+
+    template<typename U>
+    bool operator==(const SlabAllocator<U>& o) const { return arena == o.arena; }
+    template<typename U>
+    bool operator!=(const SlabAllocator<U>& o) const { return arena != o.arena; }
+};
+
+// Memory breakdown reported by printStats()
+struct MemoryFootprint {
+    size_t tableBytes = 0;   // bucket / slot / control arrays
+    size_t entryBytes = 0;   // memory actually held for entries (incl. node links)
+    size_t slackBytes = 0;   // reserved by the allocator but not holding an entry
+    bool   estimated  = false;
+
+    void print(size_t entries) const {
+        size_t total = tableBytes + entryBytes + slackBytes;
+        cout << "  Memory      : " << total << " bytes (table " << tableBytes
+             << ", entries " << entryBytes << ", slack " << slackBytes << ")"
+             << (estimated ? " (est. for glibc malloc)" : "") << "\n";
+        cout << "  Bytes/entry : " << fixed << setprecision(1)
+             << (entries ? (double)total / entries : 0.0) << "\n";
+    }
+};
+
+// -- Key hashing ------------------------------------------------------------
+// probe_type is what lookups take. String keys hash transparently through
+// string_view (same hash as the string), so literals and slices of a larger
+// buffer are probed without building a temporary std::string.
+template<typename K>
+struct KeyHash : hash<K> {
+    using probe_type = K;
+};
+
+template<>
+struct KeyHash<string> {
+    using is_transparent = void;
+    using probe_type     = string_view;
+    size_t operator()(string_view s) const { return hash<string_view>{}(s); }
+};
+
+template<typename K, typename V> class HashMapImage;
+
 // -- Generic HashMap (separate chaining) -----------------------------------
-template<typename K, typename V>
+// Alloc is rebound to the chain node type, e.g. SlabAllocator<char>.
+template<typename K, typename V, typename Storage = Chaining, typename Alloc = allocator<char>>
 class HashMap {
+    static_assert(is_same_v<Storage, Chaining>, "Unknown HashMap storage policy.");
 public:
+    using Probe = typename KeyHash<K>::probe_type;
+
     struct Entry {
         K key;
         V value;
@@ -20,85 +209,309 @@ public:
     };
 
 private:
-    vector<list<Entry>>  buckets;
+    // Intrusive singly-linked chain node; the map holds the only allocator
+    struct Node {
+        Node* next;
+        Entry entry;
+        template<typename... Args>
+        Node(Node* n, Args&&... args) : next(n), entry(forward<Args>(args)...) {}
+    };
+
+    using NodeAlloc  = typename allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = allocator_traits<NodeAlloc>;
+
+    // Bucket heads live in fixed-size segments that are allocated the first time
+    // one of their buckets is written and freed as soon as migration has drained
+    // them, so a resize never builds or frees a whole bucket array at once.
+    static constexpr size_t kSegment = 1024;
+
+    struct BucketTable {
+        vector<vector<Node*>> segments;   // empty segment = every bucket in it is empty
+        size_t                count = 0;
+
+        void reset(size_t n) {
+            count = n;
+            segments.assign((n + kSegment - 1) / kSegment, vector<Node*>());
+        }
+
+        Node* head(size_t i) const {
+            const auto& seg = segments[i / kSegment];
+            return seg.empty() ? nullptr : seg[i % kSegment];
+        }
+
+        // Link to the bucket's first node, allocating its segment if needed
+        Node*& slot(size_t i) {
+            auto& seg = segments[i / kSegment];
+            if (seg.empty()) seg.assign(min(kSegment, count - i / kSegment * kSegment), nullptr);
+            return seg[i % kSegment];
+        }
+
+        bool allocated(size_t i) const { return !segments[i / kSegment].empty(); }
+
+        void releaseSegment(size_t s) { vector<Node*>().swap(segments[s]); }
+        void release()                { count = 0; vector<vector<Node*>>().swap(segments); }
+        bool empty() const            { return count == 0; }
+
+        size_t allocatedBuckets() const {
+            size_t n = 0;
+            for (const auto& seg : segments) n += seg.capacity();
+            return n;
+        }
+
+        // Visits every node in buckets [from, count); fn may free the node
+        template<typename Fn>
+        void forEachNode(size_t from, Fn fn) const {
+            for (size_t i = from; i < count; i++) {
+                if (i % kSegment == 0 && segments[i / kSegment].empty()) { i += kSegment - 1; continue; }
+                for (Node *n = head(i), *next; n; n = next) {
+                    next = n->next;
+                    fn(n);
+                }
+            }
+        }
+    };
+
+    NodeAlloc            nodeAlloc;
+    BucketTable          buckets;
+    BucketTable          oldBuckets;   // non-empty while an incremental resize is in flight
+    size_t               migrated;     // old buckets already moved into `buckets`
     size_t               sz;
     size_t               capacity;
     float                maxLoad;
+    bool                 incremental;  // spread rehash work across operations
+    size_t               migrateStep;  // old buckets moved per mutating operation
+    bool                 logRehash;
+
+    static size_t hashOf(const Probe& key) { return KeyHash<K>{}(key); }
+
+    size_t hashKey(const Probe& key) const {
+        return hashOf(key) % capacity;
+    }
+
+    bool resizing() const { return !oldBuckets.empty(); }
+
+    template<typename... Args>
+    Node* newNode(Node* next, Args&&... args) {
+        Node* n = NodeTraits::allocate(nodeAlloc, 1);
+        try {
+            NodeTraits::construct(nodeAlloc, n, next, forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(nodeAlloc, n, 1);
+            throw;
+        }
+        return n;
+    }
+
+    void deleteNode(Node* n) {
+        NodeTraits::destroy(nodeAlloc, n);
+        NodeTraits::deallocate(nodeAlloc, n, 1);
+    }
+
+    void destroyNodes(BucketTable& table, size_t from) {
+        table.forEachNode(from, [&](Node* n) { deleteNode(n); });
+        table.release();
+    }
 
-    size_t hashKey(const K& key) const {
-        return hash<K>{}(key) % capacity;
+    // Entries move by relinking their nodes: no copy, no allocation
+    void migrateBucket(Node*& chain) {
+        while (Node* n = chain) {
+            chain = n->next;
+            Node*& dst = buckets.slot(hashKey(n->entry.key));
+            n->next = dst;
+            dst = n;
+        }
     }
 
+    // Moves up to `count` old buckets; a never-allocated old segment is skipped
+    // as one step, and each old segment is freed once it has been drained
+    void migrateSome(size_t count) {
+        while (count-- > 0 && migrated < oldBuckets.count) {
+            size_t s = migrated / kSegment;
+            size_t segEnd = min((s + 1) * kSegment, oldBuckets.count);
+            if (oldBuckets.allocated(migrated)) {
+                migrateBucket(oldBuckets.slot(migrated));
+                migrated++;
+            } else {
+                migrated = segEnd;
+            }
+            if (migrated == segEnd) oldBuckets.releaseSegment(s);
+        }
+        if (migrated == oldBuckets.count) {
+            oldBuckets.release();
+            migrated = 0;
+        }
+    }
+
+    // Only the segment directory is allocated here; segments follow on first touch
     void rehash() {
-        size_t newCap = capacity * 2;
-        vector<list<Entry>> newBuckets(newCap);
-        for (auto& chain : buckets)
-            for (auto& e : chain)
-                newBuckets[hash<K>{}(e.key) % newCap].emplace_back(e.key, e.value);
-        buckets  = move(newBuckets);
-        capacity = newCap;
-        cout << "  [rehash] -> capacity: " << capacity << ", load: "
-             << fixed << setprecision(2) << loadFactor() << "\n";
+        if (resizing()) migrateSome(oldBuckets.count);   // finish the previous one first
+        oldBuckets = move(buckets);
+        buckets.reset(capacity * 2);
+        capacity  *= 2;
+        migrated   = 0;
+        if (!incremental) migrateSome(oldBuckets.count);
+        if (logRehash)
+            cout << "  [rehash] -> capacity: " << capacity << ", load: "
+                 << fixed << setprecision(2) << loadFactor()
+                 << (incremental ? " (incremental)" : "") << "\n";
+    }
+
+    // Locate key (hash h) in the new table, then in the not-yet-migrated part of the old one
+    const Entry* findEntry(const Probe& key, size_t h) const {
+        for (Node* n = buckets.head(h % capacity); n; n = n->next)
+            if (n->entry.key == key) return &n->entry;
+        if (resizing()) {
+            size_t i = h % oldBuckets.count;
+            if (i >= migrated)
+                for (Node* n = oldBuckets.head(i); n; n = n->next)
+                    if (n->entry.key == key) return &n->entry;
+        }
+        return nullptr;
+    }
+
+    Entry* findEntry(const Probe& key, size_t h) {
+        return const_cast<Entry*>(as_const(*this).findEntry(key, h));
+    }
+
+    // Lookup-or-insert with a single hash; the key is only materialized on insert
+    template<typename... Args>
+    pair<Entry*, bool> findOrInsert(const Probe& key, Args&&... args) {
+        if (resizing()) migrateSome(migrateStep);
+        size_t h = hashOf(key);
+        if (Entry* e = findEntry(key, h)) return {e, false};
+        if ((float)(sz + 1) / capacity > maxLoad) rehash();
+        Node*& head = buckets.slot(h % capacity);
+        head = newNode(head, K(key), V(forward<Args>(args)...));
+        sz++;
+        return {&head->entry, true};
     }
 
 public:
-    explicit HashMap(size_t cap = 8, float maxLF = 0.75f)
-        : buckets(cap), sz(0), capacity(cap), maxLoad(maxLF) {}
+    explicit HashMap(size_t cap = 8, float maxLF = 0.75f, const Alloc& alloc = Alloc())
+        : nodeAlloc(alloc), migrated(0), sz(0), capacity(max<size_t>(cap, 1)), maxLoad(maxLF),
+          incremental(false), migrateStep(4), logRehash(true) {
+        buckets.reset(capacity);
+    }
+
+    // A copy gets its own allocator state (a fresh arena for SlabAllocator)
+    HashMap(const HashMap& other)
+        : nodeAlloc(NodeTraits::select_on_container_copy_construction(other.nodeAlloc)), migrated(0), sz(0),
+          capacity(other.capacity), maxLoad(other.maxLoad), incremental(other.incremental),
+          migrateStep(other.migrateStep), logRehash(other.logRehash) {
+        buckets.reset(capacity);
+        other.forEach([&](const K& k, const V& v){ put(k, v); });
+    }
+
+    // The source keeps a small empty table and stays usable. That costs a
+    // one-entry segment directory; running out of memory there terminates.
+    HashMap(HashMap&& other) noexcept
+        : nodeAlloc(other.nodeAlloc), buckets(move(other.buckets)), oldBuckets(move(other.oldBuckets)),
+          migrated(other.migrated), sz(other.sz), capacity(other.capacity), maxLoad(other.maxLoad),
+          incremental(other.incremental), migrateStep(other.migrateStep), logRehash(other.logRehash) {
+        other.oldBuckets.release();
+        other.migrated = other.sz = 0;
+        other.capacity = 8;
+        other.buckets.reset(other.capacity);
+    }
+
+    HashMap& operator=(HashMap other) noexcept {
+        swap(nodeAlloc, other.nodeAlloc);
+        swap(buckets, other.buckets);           swap(oldBuckets, other.oldBuckets);
+        swap(migrated, other.migrated);         swap(sz, other.sz);
+        swap(capacity, other.capacity);         swap(maxLoad, other.maxLoad);
+        swap(incremental, other.incremental);   swap(migrateStep, other.migrateStep);
+        swap(logRehash, other.logRehash);
+        return *this;
+    }
+
+    ~HashMap() {
+        destroyNodes(buckets, 0);
+        destroyNodes(oldBuckets, migrated);
+    }
+
+    // Incremental mode keeps both bucket arrays alive after a resize and moves
+    // `bucketsPerOp` old buckets on every put/remove/[] until the old one is drained.
+    void setIncrementalRehash(bool on, size_t bucketsPerOp = 4) {
+        if (!on && resizing()) migrateSome(oldBuckets.count);
+        incremental = on;
+        migrateStep = max<size_t>(bucketsPerOp, 2);   // >= 2 finishes before the next resize
+    }
+
+    void setRehashLogging(bool on) { logRehash = on; }
 
     // Insert or update
     void put(const K& key, const V& value) {
-        if ((float)(sz + 1) / capacity > maxLoad) rehash();
-        size_t i = hashKey(key);
-        for (auto& e : buckets[i]) {
-            if (e.key == key) { e.value = value; return; }
-        }
-        buckets[i].emplace_back(key, value);
-        sz++;
+        insert_or_assign(key, value);
+    }
+
+    // Insert V(args...) only if key is absent; returns {value, inserted}
+    template<typename... Args>
+    pair<V*, bool> try_emplace(const Probe& key, Args&&... args) {
+        auto [e, inserted] = findOrInsert(key, forward<Args>(args)...);
+        return {&e->value, inserted};
+    }
+
+    // Insert or overwrite; returns true if the key was new
+    bool insert_or_assign(const Probe& key, V value) {
+        auto [e, inserted] = findOrInsert(key, move(value));
+        if (!inserted) e->value = move(value);
+        return inserted;
     }
 
     // Get by key (throws if not found)
-    V& get(const K& key) {
-        size_t i = hashKey(key);
-        for (auto& e : buckets[i])
-            if (e.key == key) return e.value;
+    V& get(const Probe& key) {
+        if (Entry* e = findEntry(key, hashOf(key))) return e->value;
         throw out_of_range("Key not found.");
     }
 
-    const V& get(const K& key) const {
-        size_t i = hashKey(key);
-        for (const auto& e : buckets[i])
-            if (e.key == key) return e.value;
+    const V& get(const Probe& key) const {
+        if (const Entry* e = findEntry(key, hashOf(key))) return e->value;
         throw out_of_range("Key not found.");
     }
 
     // Get with default (no throw)
-    V getOrDefault(const K& key, const V& def) const {
-        size_t i = hashKey(key);
-        for (const auto& e : buckets[i])
-            if (e.key == key) return e.value;
-        return def;
+    V getOrDefault(const Probe& key, const V& def) const {
+        const Entry* e = findEntry(key, hashOf(key));
+        return e ? e->value : def;
     }
 
-    bool contains(const K& key) const {
-        size_t i = hashKey(key);
-        for (const auto& e : buckets[i])
-            if (e.key == key) return true;
-        return false;
+    bool contains(const Probe& key) const {
+        return findEntry(key, hashOf(key)) != nullptr;
     }
 
-    bool remove(const K& key) {
-        size_t i = hashKey(key);
-        auto& chain = buckets[i];
-        for (auto it = chain.begin(); it != chain.end(); ++it) {
-            if (it->key == key) { chain.erase(it); sz--; return true; }
-        }
-        return false;
+    bool remove(const Probe& key) {
+        if (resizing()) migrateSome(migrateStep);
+        auto eraseFrom = [&](BucketTable& table, size_t i) {
+            if (!table.allocated(i)) return false;
+            for (Node** link = &table.slot(i); *link; link = &(*link)->next) {
+                if ((*link)->entry.key == key) {
+                    Node* n = *link;
+                    *link = n->next;
+                    deleteNode(n);
+                    sz--;
+                    return true;
+                }
+            }
+            return false;
+        };
+        size_t h = hashOf(key);
+        if (eraseFrom(buckets, h % capacity)) return true;
+        if (!resizing()) return false;
+        size_t i = h % oldBuckets.count;
+        return i >= migrated && eraseFrom(oldBuckets, i);
+    }
+
+    // Subscript: insert default if absent (single hash)
+    V& operator[](const Probe& key) {
+        return *try_emplace(key).first;
     }
 
-    // Subscript: insert default if absent
-    V& operator[](const K& key) {
-        if (!contains(key)) put(key, V{});
-        return get(key);
+    // Drop every entry and bucket segment; capacity and settings are kept
+    void clear() {
+        destroyNodes(buckets, 0);
+        destroyNodes(oldBuckets, migrated);
+        migrated = sz = 0;
+        buckets.reset(capacity);
     }
 
     size_t size()     const { return sz; }
@@ -106,54 +519,89 @@ public:
     float  loadFactor() const { return (float)sz / capacity; }
     size_t bucketCount() const { return capacity; }
 
+    // Iterator-style forEach
+    void forEach(function<void(const K&, const V&)> fn) const {
+        auto visit = [&](const Node* n) { fn(n->entry.key, n->entry.value); };
+        buckets.forEachNode(0, visit);
+        oldBuckets.forEachNode(migrated, visit);
+    }
+
+    // Flat, offset-based snapshot that mapImage() queries in place (see HashMapImage)
+    void saveImage(const string& path) const { HashMapImage<K,V>::save(path, *this); }
+    static HashMapImage<K,V> mapImage(const string& path) { return HashMapImage<K,V>(path); }
+
     // All keys
     vector<K> keys() const {
         vector<K> result;
-        for (const auto& chain : buckets)
-            for (const auto& e : chain) result.push_back(e.key);
+        forEach([&](const K& k, const V&){ result.push_back(k); });
         return result;
     }
 
     // All values
     vector<V> values() const {
         vector<V> result;
-        for (const auto& chain : buckets)
-            for (const auto& e : chain) result.push_back(e.value);
+        forEach([&](const K&, const V& v){ result.push_back(v); });
         return result;
     }
 
     // All entries
     vector<Entry> entries() const {
         vector<Entry> result;
-        for (const auto& chain : buckets)
-            for (const auto& e : chain) result.push_back(e);
+        forEach([&](const K& k, const V& v){ result.emplace_back(k, v); });
         return result;
     }
 
-    // Iterator-style forEach
-    void forEach(function<void(const K&, const V&)> fn) const {
-        for (const auto& chain : buckets)
-            for (const auto& e : chain) fn(e.key, e.value);
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint m;
+        m.tableBytes = (buckets.allocatedBuckets() + oldBuckets.allocatedBuckets()) * sizeof(Node*)
+                     + (buckets.segments.capacity() + oldBuckets.segments.capacity()) * sizeof(vector<Node*>);
+        if constexpr (is_same_v<NodeAlloc, SlabAllocator<Node>>) {
+            m.entryBytes = nodeAlloc.stats().liveBytes();
+            m.slackBytes = nodeAlloc.stats().reservedBytes() - m.entryBytes;
+        } else {
+            // node = entry + next link; malloc chunk = node + 8-byte header, 16-byte rounded
+            size_t node  = sizeof(Node);
+            size_t chunk = max<size_t>(32, (node + 8 + 15) / 16 * 16);
+            m.entryBytes = sz * node;
+            m.slackBytes = sz * (chunk - node);
+            m.estimated  = true;
+        }
+        return m;
     }
 
     // Stats
+    // Mid-resize, chain figures and the distribution cover the new table plus
+    // the old buckets not yet migrated; used buckets are shown per table
     void printStats() const {
-        int usedBuckets = 0, maxChain = 0, totalChain = 0;
+        int maxChain = 0, totalChain = 0, usedChains = 0;
         vector<int> distribution(10, 0);
-        for (const auto& chain : buckets) {
-            int len = (int)chain.size();
-            if (len > 0) usedBuckets++;
-            maxChain   = max(maxChain, len);
-            totalChain += len;
-            if (len < 10) distribution[len]++;
-        }
+        auto tally = [&](const BucketTable& table, size_t from) {
+            int used = 0;
+            for (size_t i = from; i < table.count; i++) {
+                int len = 0;
+                for (Node* n = table.head(i); n; n = n->next) len++;
+                if (len > 0) used++;
+                maxChain   = max(maxChain, len);
+                totalChain += len;
+                if (len < 10) distribution[len]++;
+            }
+            usedChains += used;
+            return used;
+        };
+        int usedBuckets = tally(buckets, 0);
+        int usedOld     = resizing() ? tally(oldBuckets, migrated) : 0;
         cout << "  Size        : " << sz << "\n";
         cout << "  Capacity    : " << capacity << "\n";
         cout << "  Load factor : " << fixed << setprecision(3) << loadFactor() << "\n";
         cout << "  Used buckets: " << usedBuckets << " / " << capacity << "\n";
+        if (resizing())
+            cout << "  Resizing    : " << migrated << " / " << oldBuckets.count
+                 << " old buckets migrated, " << usedOld << " / " << oldBuckets.count - migrated
+                 << " remaining old buckets used\n";
         cout << "  Max chain   : " << maxChain << "\n";
         cout << "  Avg chain   : " << fixed << setprecision(2)
-             << (usedBuckets > 0 ? (float)totalChain / usedBuckets : 0.0f) << "\n";
+             << (usedChains > 0 ? (float)totalChain / usedChains : 0.0f) << "\n";
+        memoryFootprint().print(sz);
         cout << "  Distribution (chain_len: count):\n";
         for (int i = 0; i < 10; i++)
             if (distribution[i] > 0) cout << "    len=" << i << ": " << distribution[i] << " bucket(s)\n";
@@ -174,17 +622,937 @@ public:
     }
 };
 
+// -- Swiss table helpers ----------------------------------------------------
+// Control byte per slot: kEmpty, kDeleted (tombstone) or the low 7 hash bits
+// (h2) of the entry stored there. Slots are probed a group at a time, and a
+// whole group of control bytes is compared against h2 in one SIMD op.
+namespace swiss {
+    constexpr int8_t kEmpty   = -128;
+    constexpr int8_t kDeleted = -2;
+    constexpr size_t kGroupWidth = 16;
+
+    inline int lowestBit(uint32_t m) {
+#if defined(__GNUC__)
+        return __builtin_ctz(m);
+#else
+        int i = 0;
+        while (!(m & 1u)) { m >>= 1; i++; }
+        return i;
+#endif
+    }
+
+    // Bitmasks over the 16 control bytes of one group
+    struct Group {
+#ifdef __SSE2__
+        __m128i ctrl;
+        explicit Group(const int8_t* p) : ctrl(_mm_loadu_si128((const __m128i*)p)) {}
+
+        uint32_t match(int8_t h2) const {
+            return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl));
+        }
+        uint32_t matchEmpty() const { return match(kEmpty); }
+        // Full slots are >= 0, empty and deleted are both negative
+        uint32_t matchEmptyOrDeleted() const {
+            return (uint32_t)_mm_movemask_epi8(ctrl);
+        }
+#else
+        const int8_t* ctrl;
+        explicit Group(const int8_t* p) : ctrl(p) {}
+
+        uint32_t match(int8_t h2) const {
+            uint32_t m = 0;
+            for (size_t i = 0; i < kGroupWidth; i++) if (ctrl[i] == h2) m |= 1u << i;
+            return m;
+        }
+        uint32_t matchEmpty() const { return match(kEmpty); }
+        uint32_t matchEmptyOrDeleted() const {
+            uint32_t m = 0;
+            for (size_t i = 0; i < kGroupWidth; i++) if (ctrl[i] < 0) m |= 1u << i;
+            return m;
+        }
+#endif
+    };
+
+    // std::hash<int> is the identity, so spread the bits before masking
+    inline uint64_t mix(uint64_t h) {
+        h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+}
+
+// -- HashMap (open addressing, Swiss table) ---------------------------------
+template<typename K, typename V, typename Alloc>
+class HashMap<K, V, OpenAddressing, Alloc> {
+public:
+    using Probe = typename KeyHash<K>::probe_type;
+
+    struct Entry {
+        K key;
+        V value;
+        Entry(K k, V v) : key(move(k)), value(move(v)) {}
+    };
+
+private:
+    static constexpr size_t G    = swiss::kGroupWidth;
+    static constexpr size_t npos = size_t(-1);
+    using SlotAlloc   = typename allocator_traits<Alloc>::template rebind_alloc<Entry>;
+    using AllocTraits = allocator_traits<SlotAlloc>;
+
+    SlotAlloc      slotAlloc;
+    vector<int8_t> ctrl;        // one control byte per slot
+    Entry*         slots;       // raw storage, constructed where ctrl is full
+    size_t         sz;
+    size_t         tombstones;
+    size_t         capacity;    // power of two, multiple of G
+    float          maxLoad;
+    bool           logRehash;
+
+    static size_t roundCapacity(size_t cap) {
+        size_t c = G;
+        while (c < cap) c <<= 1;
+        return c;
+    }
+
+    uint64_t hashOf(const Probe& key) const { return swiss::mix(KeyHash<K>{}(key)); }
+    static int8_t h2(uint64_t h)        { return (int8_t)(h & 0x7F); }
+    size_t groupMask() const            { return capacity / G - 1; }
+
+    // Triangular probing over groups: visits every group once
+    size_t findIndex(const Probe& key, uint64_t h) const {
+        if (capacity == 0) return npos;   // moved-from: no table until the next insert
+        size_t g = (h >> 7) & groupMask();
+        for (size_t step = 1; ; step++) {
+            swiss::Group grp(&ctrl[g * G]);
+            for (uint32_t m = grp.match(h2(h)); m; m &= m - 1) {
+                size_t i = g * G + swiss::lowestBit(m);
+                if (slots[i].key == key) return i;
+            }
+            if (grp.matchEmpty()) return npos;
+            g = (g + step) & groupMask();
+        }
+    }
+
+    size_t findInsertSlot(uint64_t h) const {
+        size_t g = (h >> 7) & groupMask();
+        for (size_t step = 1; ; step++) {
+            uint32_t m = swiss::Group(&ctrl[g * G]).matchEmptyOrDeleted();
+            if (m) return g * G + swiss::lowestBit(m);
+            g = (g + step) & groupMask();
+        }
+    }
+
+    // Groups visited before reaching the group that holds slot i
+    size_t probeLength(size_t i) const {
+        size_t g = (hashOf(slots[i].key) >> 7) & groupMask(), n = 1;
+        for (size_t step = 1; g != i / G; step++, n++) g = (g + step) & groupMask();
+        return n;
+    }
+
+    void allocate(size_t cap) {
+        capacity = cap;
+        ctrl.assign(cap, swiss::kEmpty);
+        slots = slotAlloc.allocate(cap);
+    }
+
+    void release() {
+        if (!slots) return;
+        for (size_t i = 0; i < capacity; i++)
+            if (ctrl[i] >= 0) slots[i].~Entry();
+        slotAlloc.deallocate(slots, capacity);
+        slots = nullptr;
+    }
+
+    // Grow when live entries need it, otherwise rebuild in place to drop tombstones
+    void rehash() {
+        size_t newCap = capacity == 0 ? G : (sz + 1 > capacity * maxLoad / 2) ? capacity * 2 : capacity;
+        vector<int8_t> oldCtrl = move(ctrl);
+        Entry* oldSlots = slots;
+        size_t oldCap   = capacity;
+        allocate(newCap);
+        for (size_t i = 0; i < oldCap; i++) {
+            if (oldCtrl[i] < 0) continue;
+            uint64_t h = hashOf(oldSlots[i].key);
+            size_t j = findInsertSlot(h);
+            new (&slots[j]) Entry(move(oldSlots[i]));
+            ctrl[j] = h2(h);
+            oldSlots[i].~Entry();
+        }
+        if (oldSlots) slotAlloc.deallocate(oldSlots, oldCap);
+        tombstones = 0;
+        if (logRehash)
+            cout << "  [rehash] -> capacity: " << capacity << ", load: "
+                 << fixed << setprecision(2) << loadFactor() << "\n";
+    }
+
+    size_t insertNew(K key, V value, uint64_t h) {
+        if (capacity == 0 || (float)(sz + tombstones + 1) / capacity > maxLoad) rehash();
+        size_t i = findInsertSlot(h);
+        if (ctrl[i] == swiss::kDeleted) tombstones--;
+        new (&slots[i]) Entry(move(key), move(value));
+        ctrl[i] = h2(h);
+        sz++;
+        return i;
+    }
+
+    // Lookup-or-insert with a single probe; the key is only materialized on insert
+    template<typename... Args>
+    pair<size_t, bool> findOrInsert(const Probe& key, Args&&... args) {
+        uint64_t h = hashOf(key);
+        size_t i = findIndex(key, h);
+        if (i != npos) return {i, false};
+        return {insertNew(K(key), V(forward<Args>(args)...), h), true};
+    }
+
+public:
+    // maxLF is capped at 7/8 so every probe sequence reaches an empty slot
+    explicit HashMap(size_t cap = 16, float maxLF = 0.875f, const Alloc& alloc = Alloc())
+        : slotAlloc(alloc), slots(nullptr), sz(0), tombstones(0), capacity(0), maxLoad(min(maxLF, 0.875f)),
+          logRehash(true) {
+        allocate(roundCapacity(cap));
+    }
+
+    // A copy gets its own allocator state (a fresh arena for SlabAllocator)
+    HashMap(const HashMap& other)
+        : slotAlloc(AllocTraits::select_on_container_copy_construction(other.slotAlloc)), slots(nullptr), sz(0), tombstones(0), capacity(0), maxLoad(other.maxLoad),
+          logRehash(other.logRehash) {
+        allocate(roundCapacity(other.capacity));
+        other.forEach([&](const K& k, const V& v){ put(k, v); });
+    }
+
+    // The source is left empty with no table; its next insert allocates one
+    HashMap(HashMap&& other) noexcept
+        : slotAlloc(other.slotAlloc), ctrl(move(other.ctrl)), slots(other.slots), sz(other.sz),
+          tombstones(other.tombstones), capacity(other.capacity), maxLoad(other.maxLoad),
+          logRehash(other.logRehash) {
+        other.slots = nullptr;
+        other.sz = other.tombstones = other.capacity = 0;
+    }
+
+    HashMap& operator=(HashMap other) noexcept {
+        swap(slotAlloc, other.slotAlloc);
+        swap(ctrl, other.ctrl);             swap(slots, other.slots);
+        swap(sz, other.sz);                 swap(tombstones, other.tombstones);
+        swap(capacity, other.capacity);     swap(maxLoad, other.maxLoad);
+        swap(logRehash, other.logRehash);
+        return *this;
+    }
+
+    ~HashMap() { release(); }
+
+    void setRehashLogging(bool on) { logRehash = on; }
+
+    // Insert or update
+    void put(const K& key, const V& value) {
+        insert_or_assign(key, value);
+    }
+
+    // Insert V(args...) only if key is absent; returns {value, inserted}
+    template<typename... Args>
+    pair<V*, bool> try_emplace(const Probe& key, Args&&... args) {
+        auto [i, inserted] = findOrInsert(key, forward<Args>(args)...);
+        return {&slots[i].value, inserted};
+    }
+
+    // Insert or overwrite; returns true if the key was new
+    bool insert_or_assign(const Probe& key, V value) {
+        auto [i, inserted] = findOrInsert(key, move(value));
+        if (!inserted) slots[i].value = move(value);
+        return inserted;
+    }
+
+    // Get by key (throws if not found)
+    V& get(const Probe& key) {
+        size_t i = findIndex(key, hashOf(key));
+        if (i == npos) throw out_of_range("Key not found.");
+        return slots[i].value;
+    }
+
+    const V& get(const Probe& key) const {
+        size_t i = findIndex(key, hashOf(key));
+        if (i == npos) throw out_of_range("Key not found.");
+        return slots[i].value;
+    }
+
+    // Get with default (no throw)
+    V getOrDefault(const Probe& key, const V& def) const {
+        size_t i = findIndex(key, hashOf(key));
+        return i == npos ? def : slots[i].value;
+    }
+
+    bool contains(const Probe& key) const {
+        return findIndex(key, hashOf(key)) != npos;
+    }
+
+    // A slot can go straight back to empty if its group still has an empty
+    // slot: no probe sequence ever continued past that group.
+    bool remove(const Probe& key) {
+        size_t i = findIndex(key, hashOf(key));
+        if (i == npos) return false;
+        slots[i].~Entry();
+        if (swiss::Group(&ctrl[i / G * G]).matchEmpty()) ctrl[i] = swiss::kEmpty;
+        else { ctrl[i] = swiss::kDeleted; tombstones++; }
+        sz--;
+        return true;
+    }
+
+    // Subscript: insert default if absent (single probe)
+    V& operator[](const Probe& key) {
+        return *try_emplace(key).first;
+    }
+
+    size_t size()     const { return sz; }
+    bool   empty()    const { return sz == 0; }
+    float  loadFactor() const { return capacity ? (float)sz / capacity : 0.0f; }
+    size_t bucketCount() const { return capacity; }
+
+    // Iterator-style forEach
+    void forEach(function<void(const K&, const V&)> fn) const {
+        for (size_t i = 0; i < capacity; i++)
+            if (ctrl[i] >= 0) fn(slots[i].key, slots[i].value);
+    }
+
+    // Flat, offset-based snapshot that mapImage() queries in place (see HashMapImage)
+    void saveImage(const string& path) const { HashMapImage<K,V>::save(path, *this); }
+    static HashMapImage<K,V> mapImage(const string& path) { return HashMapImage<K,V>(path); }
+
+    vector<K> keys() const {
+        vector<K> result;
+        forEach([&](const K& k, const V&){ result.push_back(k); });
+        return result;
+    }
+
+    vector<V> values() const {
+        vector<V> result;
+        forEach([&](const K&, const V& v){ result.push_back(v); });
+        return result;
+    }
+
+    vector<Entry> entries() const {
+        vector<Entry> result;
+        forEach([&](const K& k, const V& v){ result.emplace_back(k, v); });
+        return result;
+    }
+
+    // Empty and deleted slots are the slack of an open-addressing table
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint m;
+        m.tableBytes = ctrl.capacity();
+        m.entryBytes = sz * sizeof(Entry);
+        m.slackBytes = (capacity - sz) * sizeof(Entry);
+        return m;
+    }
+
+    // Stats
+    void printStats() const {
+        size_t maxProbe = 0, totalProbe = 0;
+        vector<int> distribution(10, 0);
+        for (size_t i = 0; i < capacity; i++) {
+            if (ctrl[i] < 0) continue;
+            size_t len = probeLength(i);
+            maxProbe    = max(maxProbe, len);
+            totalProbe += len;
+            if (len < 10) distribution[len]++;
+        }
+        cout << "  Size        : " << sz << "\n";
+        cout << "  Capacity    : " << capacity << " slots (" << capacity / G << " groups)\n";
+        cout << "  Load factor : " << fixed << setprecision(3) << loadFactor() << "\n";
+        cout << "  Tombstones  : " << tombstones << "\n";
+        cout << "  Max probe   : " << maxProbe << " group(s)\n";
+        cout << "  Avg probe   : " << fixed << setprecision(2)
+             << (sz > 0 ? (float)totalProbe / sz : 0.0f) << " group(s)\n";
+        memoryFootprint().print(sz);
+        cout << "  Distribution (groups_probed: count):\n";
+        for (int i = 1; i < 10; i++)
+            if (distribution[i] > 0) cout << "    probe=" << i << ": " << distribution[i] << " entry(ies)\n";
+    }
+
+    void printAll() const {
+        auto es = entries();
+        sort(es.begin(), es.end(), [](const Entry& a, const Entry& b){ return a.key < b.key; });
+        cout << "{ ";
+        for (size_t i = 0; i < es.size(); i++) {
+            cout << es[i].key << ": " << es[i].value;
+            if (i + 1 < es.size()) cout << ", ";
+        }
+        cout << " }\n";
+    }
+};
+
+// -- Epoch-based reclamation ------------------------------------------------
+// Readers pin the current global epoch while they hold raw node pointers.
+// Unlinked nodes are retired with the epoch at unlink time and freed once the
+// global epoch has moved two steps past it: every reader that could still
+// see them has unpinned by then.
+class EpochDomain {
+public:
+    static constexpr int kMaxThreads = 256;
+
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    uint64_t current() const { return global.load(); }
+
+    void pin() {
+        ThreadSlot& t = threadSlot();
+        if (t.depth++ == 0) {
+            t.slot->epoch.store(global.load());
+            atomic_thread_fence(memory_order_seq_cst);   // pin before any node load
+        }
+    }
+
+    void unpin() {
+        ThreadSlot& t = threadSlot();
+        if (--t.depth == 0) t.slot->epoch.store(0);
+    }
+
+    // Advance only when every pinned thread has seen the current epoch
+    void tryAdvance() {
+        uint64_t e = global.load();
+        for (const auto& s : slots) {
+            uint64_t se = s.epoch.load();
+            if (se != 0 && se != e) return;
+        }
+        global.compare_exchange_strong(e, e + 1);
+    }
+
+    bool safeToFree(uint64_t retiredAt) const { return retiredAt + 2 <= global.load(); }
+
+private:
+    struct alignas(64) Slot {
+        atomic<uint64_t> epoch{0};   // 0 = not inside a read section
+        atomic<bool>     taken{false};
+    };
+
+    struct ThreadSlot {
+        Slot* slot  = nullptr;
+        int   depth = 0;
+        ~ThreadSlot() { if (slot) slot->taken.store(false); }
+    };
+
+    atomic<uint64_t> global{1};
+    Slot             slots[kMaxThreads];
+
+    ThreadSlot& threadSlot() {
+        static thread_local ThreadSlot t;
+        if (!t.slot) {
+            for (auto& s : slots) {
+                bool expected = false;
+                if (s.taken.compare_exchange_strong(expected, true)) { t.slot = &s; break; }
+            }
+            if (!t.slot) throw runtime_error("EpochDomain: too many threads.");
+        }
+        return t;
+    }
+};
+
+struct EpochGuard {
+    EpochGuard()  { EpochDomain::instance().pin(); }
+    ~EpochGuard() { EpochDomain::instance().unpin(); }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// -- ConcurrentHashMap (sharded chaining, lock-free reads) ------------------
+// Keys are split over independently locked shards; each shard is a chained
+// table like HashMap. Writers take the shard mutex and never modify a node a
+// reader can see: updates, removals and resizes publish new nodes/tables
+// with release stores and retire the old ones through EpochDomain. Readers
+// take no lock at all.
+template<typename K, typename V>
+class ConcurrentHashMap {
+public:
+    using Probe = typename KeyHash<K>::probe_type;
+
+private:
+    struct Node {
+        const K        key;
+        const V        value;
+        atomic<Node*>  next;
+        Node(const K& k, const V& v, Node* n) : key(k), value(v), next(n) {}
+    };
+
+    struct Table {
+        size_t                     capacity;
+        unique_ptr<atomic<Node*>[]> buckets;
+        explicit Table(size_t cap) : capacity(cap), buckets(new atomic<Node*>[cap]) {
+            for (size_t i = 0; i < cap; i++) buckets[i].store(nullptr, memory_order_relaxed);
+        }
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        Node*    node;
+        Table*   table;
+    };
+
+    struct alignas(64) Shard {
+        mutable mutex      lock;
+        atomic<Table*>     table{nullptr};
+        atomic<size_t>     sz{0};
+        vector<Retired>    retired;
+    };
+
+    static constexpr size_t kReclaimBatch = 64;
+
+    vector<Shard> shards;   // sized once in the constructor, never moved
+    float         maxLoad;
+
+    size_t hashKey(const Probe& key) const { return KeyHash<K>{}(key); }
+    Shard& shardFor(size_t h)             { return shards[h % shards.size()]; }
+    const Shard& shardFor(size_t h) const { return shards[h % shards.size()]; }
+    size_t bucketIndex(size_t h, const Table* t) const { return (h / shards.size()) % t->capacity; }
+
+    // Caller must hold an EpochGuard
+    const Node* findNode(const Probe& key) const {
+        size_t h = hashKey(key);
+        const Table* t = shardFor(h).table.load(memory_order_acquire);
+        for (Node* n = t->buckets[bucketIndex(h, t)].load(memory_order_acquire); n;
+             n = n->next.load(memory_order_acquire))
+            if (n->key == key) return n;
+        return nullptr;
+    }
+
+    // Shard lock held from here on --------------------------------------------
+    void retire(Shard& s, Node* n, Table* t) {
+        atomic_thread_fence(memory_order_seq_cst);       // unlink before reading the epoch
+        s.retired.push_back({EpochDomain::instance().current(), n, t});
+        if (s.retired.size() % kReclaimBatch == 0) reclaim(s);
+    }
+
+    void reclaim(Shard& s) {
+        auto& domain = EpochDomain::instance();
+        domain.tryAdvance();
+        auto keep = partition(s.retired.begin(), s.retired.end(),
+                              [&](const Retired& r){ return !domain.safeToFree(r.epoch); });
+        for (auto it = keep; it != s.retired.end(); ++it) { delete it->node; delete it->table; }
+        s.retired.erase(keep, s.retired.end());
+    }
+
+    // Copy every node into a twice-as-large table; the old chains stay intact
+    // for readers still walking them and are retired once the new table is live.
+    void grow(Shard& s) {
+        Table* old = s.table.load(memory_order_relaxed);
+        Table* t   = new Table(old->capacity * 2);
+        vector<Node*> oldNodes;
+        for (size_t i = 0; i < old->capacity; i++) {
+            for (Node* n = old->buckets[i].load(memory_order_relaxed); n;
+                 n = n->next.load(memory_order_relaxed)) {
+                auto& b = t->buckets[bucketIndex(hashKey(n->key), t)];
+                b.store(new Node(n->key, n->value, b.load(memory_order_relaxed)), memory_order_relaxed);
+                oldNodes.push_back(n);
+            }
+        }
+        s.table.store(t, memory_order_release);
+        for (Node* n : oldNodes) retire(s, n, nullptr);
+        retire(s, nullptr, old);
+    }
+
+public:
+    explicit ConcurrentHashMap(size_t numShards = 16, size_t shardCap = 8, float maxLF = 0.75f)
+        : shards(max<size_t>(numShards, 1)), maxLoad(maxLF) {
+        for (auto& s : shards) s.table.store(new Table(max<size_t>(shardCap, 1)));
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    // Assumes no other thread is still using the map
+    ~ConcurrentHashMap() {
+        for (auto& s : shards) {
+            Table* t = s.table.load();
+            for (size_t i = 0; i < t->capacity; i++)
+                for (Node* n = t->buckets[i].load(); n; ) {
+                    Node* next = n->next.load();
+                    delete n;
+                    n = next;
+                }
+            delete t;
+            for (auto& r : s.retired) { delete r.node; delete r.table; }
+        }
+    }
+
+    // Insert or update (replaces the node, readers see old or new value)
+    void put(const K& key, const V& value) {
+        size_t h = hashKey(key);
+        Shard& s = shardFor(h);
+        lock_guard<mutex> lk(s.lock);
+        Table* t = s.table.load(memory_order_relaxed);
+        atomic<Node*>* link = &t->buckets[bucketIndex(h, t)];
+        for (Node* n = link->load(memory_order_relaxed); n; n = link->load(memory_order_relaxed)) {
+            if (n->key == key) {
+                link->store(new Node(key, value, n->next.load(memory_order_relaxed)),
+                            memory_order_release);
+                retire(s, n, nullptr);
+                return;
+            }
+            link = &n->next;
+        }
+        if ((float)(s.sz.load(memory_order_relaxed) + 1) / t->capacity > maxLoad) {
+            grow(s);
+            t = s.table.load(memory_order_relaxed);
+        }
+        auto& head = t->buckets[bucketIndex(h, t)];
+        head.store(new Node(key, value, head.load(memory_order_relaxed)), memory_order_release);
+        s.sz.fetch_add(1, memory_order_relaxed);
+    }
+
+    bool remove(const Probe& key) {
+        size_t h = hashKey(key);
+        Shard& s = shardFor(h);
+        lock_guard<mutex> lk(s.lock);
+        Table* t = s.table.load(memory_order_relaxed);
+        atomic<Node*>* link = &t->buckets[bucketIndex(h, t)];
+        for (Node* n = link->load(memory_order_relaxed); n; n = link->load(memory_order_relaxed)) {
+            if (n->key == key) {
+                link->store(n->next.load(memory_order_relaxed), memory_order_release);
+                s.sz.fetch_sub(1, memory_order_relaxed);
+                retire(s, n, nullptr);
+                return true;
+            }
+            link = &n->next;
+        }
+        return false;
+    }
+
+    // Lock-free reads: values are returned by copy since nodes may be retired
+    V get(const Probe& key) const {
+        EpochGuard g;
+        if (const Node* n = findNode(key)) return n->value;
+        throw out_of_range("Key not found.");
+    }
+
+    V getOrDefault(const Probe& key, const V& def) const {
+        EpochGuard g;
+        const Node* n = findNode(key);
+        return n ? n->value : def;
+    }
+
+    bool contains(const Probe& key) const {
+        EpochGuard g;
+        return findNode(key) != nullptr;
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& s : shards) total += s.sz.load(memory_order_relaxed);
+        return total;
+    }
+    bool   empty()      const { return size() == 0; }
+    size_t shardCount() const { return shards.size(); }
+
+    // Weakly consistent snapshot: each shard is read lock-free
+    void forEach(function<void(const K&, const V&)> fn) const {
+        EpochGuard g;
+        for (const auto& s : shards) {
+            const Table* t = s.table.load(memory_order_acquire);
+            for (size_t i = 0; i < t->capacity; i++)
+                for (Node* n = t->buckets[i].load(memory_order_acquire); n;
+                     n = n->next.load(memory_order_acquire))
+                    fn(n->key, n->value);
+        }
+    }
+
+    void printStats() const {
+        size_t minShard = SIZE_MAX, maxShard = 0, buckets = 0, pending = 0;
+        for (const auto& s : shards) {
+            lock_guard<mutex> lk(s.lock);
+            size_t n = s.sz.load(memory_order_relaxed);
+            minShard = min(minShard, n);
+            maxShard = max(maxShard, n);
+            buckets += s.table.load(memory_order_relaxed)->capacity;
+            pending += s.retired.size();
+        }
+        cout << "  Size        : " << size() << "\n";
+        cout << "  Shards      : " << shards.size() << " (entries per shard: "
+             << minShard << ".." << maxShard << ")\n";
+        cout << "  Buckets     : " << buckets << "\n";
+        cout << "  Load factor : " << fixed << setprecision(3) << (float)size() / buckets << "\n";
+        cout << "  Retired     : " << pending << " node(s)/table(s) awaiting reclamation\n";
+    }
+};
+
+// -- Memory-mapped input ----------------------------------------------------
+// Read-only view of a whole file: mmap on POSIX, a plain read elsewhere.
+// `sequential` asks the kernel for aggressive read-ahead (streaming scans).
+class MappedFile {
+private:
+    const char* data;
+    size_t      len;
+    string      buffer;   // fallback storage when mmap is unavailable
+
+public:
+    explicit MappedFile(const string& path, bool sequential = true) : data(nullptr), len(0) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("Cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) { close(fd); throw runtime_error("Cannot stat " + path); }
+        len = (size_t)st.st_size;
+        if (len > 0) {
+            void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) { close(fd); throw runtime_error("Cannot mmap " + path); }
+            if (sequential) madvise(p, len, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(p);
+        }
+        close(fd);
+#else
+        (void)sequential;
+        ifstream in(path, ios::binary);
+        if (!in) throw runtime_error("Cannot open " + path);
+        buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        data = buffer.data();
+        len  = buffer.size();
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (data) munmap(const_cast<char*>(data), len);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    string_view view() const { return string_view(data, len); }
+    size_t      size() const { return len; }
+};
+
+// -- Memory-mappable image --------------------------------------------------
+// File layout (offsets from the start of the file, native byte order):
+//   ImageHeader
+//   uint64_t bucketStart[bucketCount + 1]   slots of bucket b: [start[b], start[b+1])
+//   Slot     slots[count]                   grouped by bucket
+//   char     strings[]                      key bytes when K is std::string
+// Nothing is deserialized: a lookup hashes the key, reads two offsets and
+// scans that bucket's slots directly in the read-only mapping.
+struct ImageHeader {
+    char     magic[8];        // "HMIMAGE"
+    uint32_t version;
+    uint32_t byteOrder;       // 0x01020304 in the writer's byte order
+    uint32_t keyBytes;
+    uint32_t valueBytes;
+    uint32_t slotBytes;
+    uint32_t stringKeys;
+    uint64_t count;
+    uint64_t bucketCount;     // power of two
+    uint64_t bucketsOffset;
+    uint64_t slotsOffset;
+    uint64_t stringsOffset;
+    uint64_t fileBytes;
+};
+
+template<typename K, typename V>
+class HashMapImage {
+    static constexpr bool kStringKeys = is_same_v<K, string>;
+    static_assert(is_trivially_copyable_v<V>, "Image values must be trivially copyable.");
+    static_assert(kStringKeys || (is_trivially_copyable_v<K> && has_unique_object_representations_v<K>),
+                  "Image keys must be std::string or trivially copyable without padding.");
+
+public:
+    using Probe = typename KeyHash<K>::probe_type;
+
+private:
+    static constexpr uint32_t kVersion = 1;
+
+    struct PodSlot { K key; V value; };
+    struct StrSlot { uint64_t hash; uint64_t keyOffset; uint64_t keyLength; V value; };
+    using Slot = conditional_t<kStringKeys, StrSlot, PodSlot>;
+
+    unique_ptr<MappedFile> file;
+    const ImageHeader*     hdr;
+    const uint64_t*        starts;
+    const Slot*            slots;
+    const char*            strings;
+
+    // FNV-1a over the key bytes: stable across processes, unlike std::hash
+    static uint64_t hashOf(const Probe& key) {
+        const unsigned char* p;
+        size_t n;
+        if constexpr (kStringKeys) { p = (const unsigned char*)key.data(); n = key.size(); }
+        else                       { p = (const unsigned char*)&key;       n = sizeof(K); }
+        uint64_t h = 14695981039346656037ULL;
+        for (size_t i = 0; i < n; i++) { h ^= p[i]; h *= 1099511628211ULL; }
+        return swiss::mix(h);
+    }
+
+    static uint64_t alignUp(uint64_t x) { return (x + 63) & ~uint64_t(63); }
+
+    // offset + count * size, or false if it does not fit in 64 bits
+    static bool spanEnd(uint64_t offset, uint64_t count, uint64_t size, uint64_t& end) {
+        if (size != 0 && count > (UINT64_MAX - offset) / size) return false;
+        end = offset + count * size;
+        return true;
+    }
+
+    // String key bytes are bounds-checked on every access rather than in a
+    // full pass over the slots at map time
+    string_view keyBytes(const Slot& s) const {
+        uint64_t poolBytes = hdr->fileBytes - hdr->stringsOffset;
+        if (s.keyOffset > poolBytes || s.keyLength > poolBytes - s.keyOffset)
+            throw runtime_error("Bad image: string key outside the string pool");
+        return string_view(strings + s.keyOffset, s.keyLength);
+    }
+
+    const Slot* find(const Probe& key) const {
+        uint64_t h = hashOf(key);
+        size_t b = h & (hdr->bucketCount - 1);
+        for (uint64_t i = starts[b]; i < starts[b + 1]; i++) {
+            const Slot& s = slots[i];
+            if constexpr (kStringKeys) {
+                if (s.hash == h && s.keyLength == key.size() && keyBytes(s) == key) return &s;
+            } else if (s.key == key) return &s;
+        }
+        return nullptr;
+    }
+
+    Probe keyOf(const Slot& s) const {
+        if constexpr (kStringKeys) return keyBytes(s);
+        else return s.key;
+    }
+
+public:
+    // Map an image written by save(); throws runtime_error if it does not fit K/V
+    explicit HashMapImage(const string& path) : file(make_unique<MappedFile>(path, false)) {
+        string_view bytes = file->view();
+        auto bad = [&](const string& why){ return runtime_error("Bad image " + path + ": " + why); };
+        if (bytes.size() < sizeof(ImageHeader)) throw bad("truncated header");
+        hdr = reinterpret_cast<const ImageHeader*>(bytes.data());
+        if (memcmp(hdr->magic, "HMIMAGE", 8) != 0) throw bad("wrong magic");
+        if (hdr->version != kVersion || hdr->byteOrder != 0x01020304u) throw bad("version/byte order");
+        if (hdr->keyBytes != sizeof(K) || hdr->valueBytes != sizeof(V) ||
+            hdr->slotBytes != sizeof(Slot) || hdr->stringKeys != (uint32_t)kStringKeys)
+            throw bad("key/value layout mismatch");
+        if (hdr->fileBytes != bytes.size() || hdr->bucketCount == 0 ||
+            (hdr->bucketCount & (hdr->bucketCount - 1)) != 0)
+            throw bad("inconsistent sizes");
+        uint64_t bucketsEnd, slotsEnd;
+        if (hdr->bucketsOffset < sizeof(ImageHeader) ||
+            !spanEnd(hdr->bucketsOffset, hdr->bucketCount + 1, sizeof(uint64_t), bucketsEnd) ||
+            bucketsEnd > hdr->slotsOffset ||
+            !spanEnd(hdr->slotsOffset, hdr->count, sizeof(Slot), slotsEnd) ||
+            slotsEnd > hdr->stringsOffset || hdr->stringsOffset > hdr->fileBytes)
+            throw bad("inconsistent offsets");
+        // The mapping is page aligned, so aligned offsets give aligned arrays
+        if (hdr->bucketsOffset % alignof(uint64_t) != 0 || hdr->slotsOffset % alignof(Slot) != 0)
+            throw bad("misaligned section");
+        starts  = reinterpret_cast<const uint64_t*>(bytes.data() + hdr->bucketsOffset);
+        slots   = reinterpret_cast<const Slot*>(bytes.data() + hdr->slotsOffset);
+        strings = bytes.data() + hdr->stringsOffset;
+        // One pass over the bucket index: every range must lie inside [0, count]
+        if (starts[0] != 0 || starts[hdr->bucketCount] != hdr->count) throw bad("bucket index out of range");
+        for (uint64_t b = 0; b < hdr->bucketCount; b++)
+            if (starts[b] > starts[b + 1]) throw bad("bucket index not monotone");
+    }
+
+    // Write any map exposing size() and forEach(key, value)
+    template<typename Map>
+    static void save(const string& path, const Map& map) {
+        struct Item { uint64_t hash; const K* key; const V* value; };
+        vector<Item> items;
+        items.reserve(map.size());
+        map.forEach([&](const K& k, const V& v){ items.push_back({hashOf(k), &k, &v}); });
+
+        uint64_t buckets = 1;
+        while (buckets < items.size()) buckets <<= 1;
+        vector<uint64_t> start(buckets + 1, 0);
+        for (const auto& it : items) start[(it.hash & (buckets - 1)) + 1]++;
+        partial_sum(start.begin(), start.end(), start.begin());
+
+        vector<Slot>     out(items.size());
+        vector<uint64_t> fill(start.begin(), start.end() - 1);
+        string           blob;
+        for (const auto& it : items) {
+            Slot& s = out[fill[it.hash & (buckets - 1)]++];
+            memset((void*)&s, 0, sizeof(Slot));
+            if constexpr (kStringKeys) {
+                s.hash      = it.hash;
+                s.keyOffset = blob.size();
+                s.keyLength = it.key->size();
+                blob += *it.key;
+            } else {
+                s.key = *it.key;
+            }
+            s.value = *it.value;
+        }
+
+        ImageHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, "HMIMAGE", 8);
+        h.version       = kVersion;
+        h.byteOrder     = 0x01020304u;
+        h.keyBytes      = sizeof(K);
+        h.valueBytes    = sizeof(V);
+        h.slotBytes     = sizeof(Slot);
+        h.stringKeys    = kStringKeys;
+        h.count         = items.size();
+        h.bucketCount   = buckets;
+        h.bucketsOffset = alignUp(sizeof(ImageHeader));
+        h.slotsOffset   = alignUp(h.bucketsOffset + start.size() * sizeof(uint64_t));
+        h.stringsOffset = alignUp(h.slotsOffset + out.size() * sizeof(Slot));
+        h.fileBytes     = h.stringsOffset + blob.size();
+
+        ofstream os(path, ios::binary | ios::trunc);
+        if (!os) throw runtime_error("Cannot write " + path);
+        auto padTo = [&](uint64_t offset){
+            static const char zeros[64] = {};
+            os.write(zeros, (streamsize)(offset - (uint64_t)os.tellp()));
+        };
+        os.write((const char*)&h, sizeof(h));
+        padTo(h.bucketsOffset);
+        os.write((const char*)start.data(), (streamsize)(start.size() * sizeof(uint64_t)));
+        padTo(h.slotsOffset);
+        os.write((const char*)out.data(), (streamsize)(out.size() * sizeof(Slot)));
+        padTo(h.stringsOffset);
+        os.write(blob.data(), (streamsize)blob.size());
+        if (!os) throw runtime_error("Write failed: " + path);
+    }
+
+    const V& get(const Probe& key) const {
+        if (const Slot* s = find(key)) return s->value;
+        throw out_of_range("Key not found.");
+    }
+
+    V getOrDefault(const Probe& key, const V& def) const {
+        const Slot* s = find(key);
+        return s ? s->value : def;
+    }
+
+    bool contains(const Probe& key) const { return find(key) != nullptr; }
+
+    size_t size()        const { return hdr->count; }
+    bool   empty()       const { return hdr->count == 0; }
+    size_t bucketCount() const { return hdr->bucketCount; }
+    size_t fileBytes()   const { return hdr->fileBytes; }
+
+    // Keys are passed as string_view for string images
+    void forEach(function<void(const Probe&, const V&)> fn) const {
+        for (uint64_t i = 0; i < hdr->count; i++) fn(keyOf(slots[i]), slots[i].value);
+    }
+};
+
 // -- Applications -----------------------------------------------------------
 
-// Word frequency counter
+// Word frequency counter: words are probed as string_view slices of a
+// lower-cased copy, so only the first occurrence of a word allocates
 HashMap<string,int> wordFrequency(const string& text) {
     HashMap<string,int> freq;
-    string word;
-    for (char c : text) {
-        if (isalpha(c)) word += tolower(c);
-        else if (!word.empty()) { freq[word]++; word.clear(); }
+    string lower(text.size(), ' ');
+    transform(text.begin(), text.end(), lower.begin(),
+              [](unsigned char c){ return isalpha(c) ? (char)tolower(c) : ' '; });
+    string_view rest = lower;
+    while (true) {
+        size_t start = rest.find_first_not_of(' ');
+        if (start == string_view::npos) break;
+        size_t end = rest.find(' ', start);
+        freq[rest.substr(start, end - start)]++;
+        if (end == string_view::npos) break;
+        rest.remove_prefix(end);
     }
-    if (!word.empty()) freq[word]++;
     return freq;
 }
 
@@ -212,6 +1580,475 @@ vector<vector<string>> groupAnagrams(const vector<string>& words) {
     return result;
 }
 
+// -- Parallel text pipeline -------------------------------------------------
+// Fixed set of worker threads reused by every parallel phase. run(n, fn)
+// hands out fn(0..n-1) to the workers and the calling thread, and returns
+// once all n calls have finished; no thread is created per phase.
+class WorkerPool {
+    vector<thread>               workers;
+    mutex                        lock;
+    condition_variable           wake, finished;
+    const function<void(int)>*   job = nullptr;
+    int                          tasks = 0;
+    atomic<int>                  nextTask{0};
+    size_t                       busy = 0;         // workers still inside the current job
+    uint64_t                     generation = 0;   // bumped once per run()
+    bool                         stopping = false;
+
+    void drain(const function<void(int)>& fn) {
+        for (int t; (t = nextTask.fetch_add(1)) < tasks; ) fn(t);
+    }
+
+    void workerLoop() {
+        uint64_t seen = 0;
+        unique_lock<mutex> lk(lock);
+        while (true) {
+            wake.wait(lk, [&]{ return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            const function<void(int)>& fn = *job;
+            lk.unlock();
+            drain(fn);
+            lk.lock();
+            if (--busy == 0) finished.notify_one();
+        }
+    }
+
+public:
+    explicit WorkerPool(int threads) {
+        for (int t = 1; t < threads; t++) workers.emplace_back([this]{ workerLoop(); });
+    }
+
+    ~WorkerPool() {
+        { lock_guard<mutex> lk(lock); stopping = true; }
+        wake.notify_all();
+        for (auto& th : workers) th.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return (int)workers.size() + 1; }
+
+    void run(int n, const function<void(int)>& fn) {
+        {
+            lock_guard<mutex> lk(lock);
+            job   = &fn;
+            tasks = n;
+            nextTask.store(0);
+            busy  = workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        drain(fn);
+        unique_lock<mutex> lk(lock);
+        finished.wait(lk, [&]{ return busy == 0; });
+    }
+};
+
+// Tree reduction: in round r, map i absorbs map i + 2^r, pairs in parallel.
+// An absorbed map is cleared right away so its memory is freed by the same task.
+template<typename Map, typename MergeFn>
+Map reduceParallel(WorkerPool& pool, vector<Map>& parts, MergeFn merge) {
+    for (size_t stride = 1; stride < parts.size(); stride *= 2) {
+        vector<size_t> targets;
+        for (size_t i = 0; i + stride < parts.size(); i += 2 * stride) targets.push_back(i);
+        pool.run((int)targets.size(), [&](int t){
+            merge(parts[targets[t]], parts[targets[t] + stride]);
+            parts[targets[t] + stride].clear();
+        });
+    }
+    return move(parts[0]);
+}
+
+// CPU time consumed by the calling thread, for per-thread rates on an
+// oversubscribed machine (falls back to wall time)
+inline double threadCpuMs() {
+#if defined(__unix__) || defined(__APPLE__)
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+#else
+    return chrono::duration<double, milli>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Phase breakdown filled in by parallelWordFrequency() when asked for
+struct PipelineTiming {
+    double countMs    = 0;   // wall time of the counting phase
+    double mergeMs    = 0;   // wall time of the reduction
+    double countCpuMs = 0;   // CPU time summed over all counting tasks
+};
+
+// Split [0, text.size()) into `parts` ranges that never cut a word in half
+vector<pair<size_t,size_t>> splitOnWords(string_view text, int parts) {
+    vector<pair<size_t,size_t>> ranges;
+    size_t begin = 0;
+    for (int p = 1; p <= parts; p++) {
+        size_t end = (p == parts) ? text.size() : max(begin, text.size() * p / parts);
+        while (end < text.size() && isalpha((unsigned char)text[end])) end++;
+        ranges.push_back({begin, end});
+        begin = end;
+    }
+    return ranges;
+}
+
+// wordFrequency() over a worker pool: each task fills its own HashMap from
+// one word-aligned chunk, then the per-task maps are merged with
+// reduceParallel on the same pool. Lower-case words are probed straight from
+// the input as string_view; only mixed-case words go through a reused
+// lower-case buffer.
+HashMap<string,int> parallelWordFrequency(string_view text, WorkerPool& pool,
+                                          PipelineTiming* timing = nullptr) {
+    int tasks = pool.size();
+    auto ranges = splitOnWords(text, tasks);
+    vector<HashMap<string,int>> parts(tasks);
+    vector<double> cpuMs(tasks);
+    auto t0 = chrono::steady_clock::now();
+    pool.run(tasks, [&](int t){
+        double cpu0 = threadCpuMs();
+        HashMap<string,int>& freq = parts[t];
+        freq.setRehashLogging(false);
+        string lower;
+        size_t i = ranges[t].first, end = ranges[t].second;
+        while (i < end) {
+            while (i < end && !isalpha((unsigned char)text[i])) i++;
+            size_t start = i;
+            bool mixed = false;
+            for (; i < end && isalpha((unsigned char)text[i]); i++)
+                mixed |= isupper((unsigned char)text[i]) != 0;
+            if (i == start) break;
+            string_view word = text.substr(start, i - start);
+            if (mixed) {
+                lower.assign(word);
+                for (char& c : lower) c = (char)tolower((unsigned char)c);
+                word = lower;
+            }
+            freq[word]++;
+        }
+        cpuMs[t] = threadCpuMs() - cpu0;
+    });
+    auto t1 = chrono::steady_clock::now();
+    auto result = reduceParallel(pool, parts, [](HashMap<string,int>& into, const HashMap<string,int>& from){
+        from.forEach([&](const string& w, const int& n){ into[w] += n; });
+    });
+    if (timing) {
+        timing->countMs    = chrono::duration<double, milli>(t1 - t0).count();
+        timing->mergeMs    = chrono::duration<double, milli>(chrono::steady_clock::now() - t1).count();
+        timing->countCpuMs = accumulate(cpuMs.begin(), cpuMs.end(), 0.0);
+    }
+    return result;
+}
+
+HashMap<string,int> parallelWordFrequency(string_view text, int threads) {
+    WorkerPool pool(max(threads, 1));
+    return parallelWordFrequency(text, pool);
+}
+
+HashMap<string,int> parallelWordFrequencyFile(const string& path, int threads) {
+    MappedFile file(path);
+    return parallelWordFrequency(file.view(), threads);
+}
+
+// groupAnagrams() over a worker pool with the same split / merge scheme
+vector<vector<string>> parallelGroupAnagrams(const vector<string>& words, int threads) {
+    WorkerPool pool(max(threads, 1));
+    threads = pool.size();
+    using Groups = HashMap<string, vector<string>>;
+    vector<Groups> parts(threads);
+    pool.run(threads, [&](int t){
+        parts[t].setRehashLogging(false);
+        size_t begin = words.size() * t / threads, end = words.size() * (t + 1) / threads;
+        string key;
+        for (size_t i = begin; i < end; i++) {
+            key = words[i];
+            sort(key.begin(), key.end());
+            parts[t][key].push_back(words[i]);
+        }
+    });
+    Groups groups = reduceParallel(pool, parts, [](Groups& into, const Groups& from){
+        from.forEach([&](const string& k, const vector<string>& v){
+            auto& dst = into[k];
+            dst.insert(dst.end(), v.begin(), v.end());
+        });
+    });
+    vector<vector<string>> result;
+    groups.forEach([&](const string&, const vector<string>& v){ result.push_back(v); });
+    return result;
+}
+
+// k most frequent words, highest first (ties alphabetical); O(n log k)
+vector<pair<string,int>> topK(const HashMap<string,int>& freq, size_t k) {
+    auto better = [](const pair<string,int>& a, const pair<string,int>& b){
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    vector<pair<string,int>> heap;   // min-heap on `better`: worst kept word on top
+    if (k == 0) return heap;
+    freq.forEach([&](const string& w, const int& n){
+        if (heap.size() < k) {
+            heap.emplace_back(w, n);
+            push_heap(heap.begin(), heap.end(), better);
+        } else if (n > heap.front().second || (n == heap.front().second && w < heap.front().first)) {
+            pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = {w, n};
+            push_heap(heap.begin(), heap.end(), better);
+        }
+    });
+    sort(heap.begin(), heap.end(), better);
+    return heap;
+}
+
+// -- Benchmarks -------------------------------------------------------------
+template<typename Fn>
+double timeMs(Fn&& fn) {
+    auto t0 = chrono::steady_clock::now();
+    fn();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+// insert / hit / miss / remove on pre-sized maps; prints ns per operation
+template<typename K, typename MakeKey>
+void benchmarkBackends(const string& label, size_t n, MakeKey makeKey) {
+    vector<K> present(n), absent(n);
+    for (size_t i = 0; i < n; i++) { present[i] = makeKey(2 * i); absent[i] = makeKey(2 * i + 1); }
+    long long sink = 0;
+
+    auto run = [&](auto& m, auto insert, auto find, auto erase) {
+        vector<double> ns;
+        ns.push_back(timeMs([&]{ for (const auto& k : present) insert(m, k); }));
+        ns.push_back(timeMs([&]{ for (const auto& k : present) sink += find(m, k); }));
+        ns.push_back(timeMs([&]{ for (const auto& k : absent)  sink += find(m, k); }));
+        ns.push_back(timeMs([&]{ for (size_t i = 0; i < n; i += 2) sink += erase(m, present[i]); }));
+        for (auto& t : ns) t = t * 1e6 / n;
+        return ns;
+    };
+
+    HashMap<K,int,Chaining>       chained(2 * n);
+    HashMap<K,int,OpenAddressing> swissMap(2 * n);
+    unordered_map<K,int>          stdMap;
+    stdMap.reserve(n);
+    chained.setRehashLogging(false);
+    swissMap.setRehashLogging(false);
+
+    auto rc = run(chained,
+        [](auto& m, const K& k){ m.put(k, 1); },
+        [](auto& m, const K& k){ return m.getOrDefault(k, 0); },
+        [](auto& m, const K& k){ return (int)m.remove(k); });
+    auto rs = run(swissMap,
+        [](auto& m, const K& k){ m.put(k, 1); },
+        [](auto& m, const K& k){ return m.getOrDefault(k, 0); },
+        [](auto& m, const K& k){ return (int)m.remove(k); });
+    auto ru = run(stdMap,
+        [](auto& m, const K& k){ m[k] = 1; },
+        [](auto& m, const K& k){ auto it = m.find(k); return it == m.end() ? 0 : it->second; },
+        [](auto& m, const K& k){ return (int)m.erase(k); });
+
+    const char* ops[] = {"insert", "get (hit)", "get (miss)", "remove"};
+    cout << label << ", n=" << n << " (ns/op)\n";
+    cout << "  " << left << setw(12) << "op" << right << setw(10) << "chained"
+         << setw(10) << "swiss" << setw(16) << "unordered_map" << "\n";
+    for (int i = 0; i < 4; i++)
+        cout << "  " << left << setw(12) << ops[i] << right << fixed << setprecision(1)
+             << setw(10) << rc[i] << setw(10) << rs[i] << setw(16) << ru[i] << "\n";
+    cout << "  (checksum " << sink << ")\n";
+}
+
+// Per-put latency while growing from the default capacity; stop-the-world
+// rehash shows up in the tail, incremental rehash spreads it out. The insert
+// sequence is deterministic, so each put keeps its fastest time over `runs`
+// runs: a rehash stall recurs at the same put every run, while a preemption
+// or page-fault stall on this (possibly shared) machine does not.
+void benchmarkPutLatency(size_t n, int runs = 3) {
+    cout << "n=" << n << " int puts from capacity 8, best of " << runs << " runs per put (ns)\n";
+    cout << "  " << left << setw(14) << "mode" << right << setw(8) << "p50" << setw(8) << "p99"
+         << setw(10) << "p99.9" << setw(12) << "max" << setw(12) << "total ms" << "\n";
+    for (bool incremental : {false, true}) {
+        vector<double> lat(n, 1e300);
+        double total = 1e300;
+        for (int r = 0; r < runs; r++) {
+            HashMap<int,int> m;
+            m.setRehashLogging(false);
+            m.setIncrementalRehash(incremental);
+            total = min(total, timeMs([&]{
+                for (size_t i = 0; i < n; i++) {
+                    auto t0 = chrono::steady_clock::now();
+                    m.put((int)(uint32_t)(i * 2654435761u), (int)i);
+                    lat[i] = min(lat[i], chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count());
+                }
+            }));
+        }
+        sort(lat.begin(), lat.end());
+        auto pct = [&](double p){ return lat[min(n - 1, (size_t)(p * n))]; };
+        cout << "  " << left << setw(14) << (incremental ? "incremental" : "stop-the-world")
+             << right << fixed << setprecision(0) << setw(8) << pct(0.50) << setw(8) << pct(0.99)
+             << setw(10) << pct(0.999) << setw(12) << lat.back()
+             << setw(12) << setprecision(1) << total << "\n";
+    }
+}
+
+// Mops/s for ConcurrentHashMap vs one mutex around HashMap, 1..64 threads.
+// Writes are half put, half remove over a fixed key space.
+void benchmarkConcurrent(size_t totalOps, int keySpace) {
+    struct Mix { const char* name; int readPct; };
+    for (Mix mix : {Mix{"read-heavy (95% get)", 95}, Mix{"write-heavy (50% get)", 50}}) {
+        cout << mix.name << ", " << totalOps << " ops over " << keySpace << " keys (Mops/s)\n";
+        cout << "  " << left << setw(9) << "threads" << right << setw(16) << "mutex+HashMap"
+             << setw(20) << "ConcurrentHashMap" << "\n";
+        for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+            HashMap<int,int> locked(2 * keySpace);
+            mutex lockedMu;
+            ConcurrentHashMap<int,int> conc(64, 2 * keySpace / 64);
+            for (int k = 0; k < keySpace; k += 2) { locked.put(k, k); conc.put(k, k); }
+            atomic<long long> sink{0};
+
+            auto drive = [&](auto get, auto put, auto remove) {
+                vector<thread> pool;
+                double ms = timeMs([&]{
+                    for (int t = 0; t < threads; t++)
+                        pool.emplace_back([&, t]{
+                            uint64_t x = 0x9E3779B97F4A7C15ULL * (t + 1);
+                            long long local = 0;
+                            for (size_t i = 0; i < totalOps / threads; i++) {
+                                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                                int key = (int)(x % keySpace), r = (int)((x >> 32) % 100);
+                                if (r < mix.readPct)   local += get(key);
+                                else if (r % 2 == 0)   put(key);
+                                else                   remove(key);
+                            }
+                            sink += local;
+                        });
+                    for (auto& th : pool) th.join();
+                });
+                return totalOps / ms / 1000.0;
+            };
+
+            double lockedMops = drive(
+                [&](int k){ lock_guard<mutex> lk(lockedMu); return locked.getOrDefault(k, 0); },
+                [&](int k){ lock_guard<mutex> lk(lockedMu); locked.put(k, k); },
+                [&](int k){ lock_guard<mutex> lk(lockedMu); locked.remove(k); });
+            double concMops = drive(
+                [&](int k){ return conc.getOrDefault(k, 0); },
+                [&](int k){ conc.put(k, k); },
+                [&](int k){ conc.remove(k); });
+            cout << "  " << left << setw(9) << threads << right << fixed << setprecision(2)
+                 << setw(16) << lockedMops << setw(20) << concMops << "\n";
+        }
+    }
+    cout << "  (hardware threads: " << thread::hardware_concurrency() << ")\n";
+}
+
+// Chained map with std::allocator vs SlabAllocator: build, churn, teardown
+void benchmarkAllocators(size_t n) {
+    cout << "n=" << n << " int->int entries, chained storage\n";
+    cout << "  " << left << setw(16) << "allocator" << right << setw(12) << "insert ms"
+         << setw(18) << "remove+reinsert" << setw(12) << "destroy ms" << setw(14) << "bytes/entry" << "\n";
+    auto run = [&](const char* name, auto* tag) {
+        using Map = remove_pointer_t<decltype(tag)>;
+        auto* m = new Map(8);
+        m->setRehashLogging(false);
+        double insertMs = timeMs([&]{ for (size_t i = 0; i < n; i++) m->put((int)i, (int)i); });
+        double churnMs  = timeMs([&]{
+            for (size_t i = 0; i < n; i += 2) m->remove((int)i);
+            for (size_t i = 0; i < n; i += 2) m->put((int)i, (int)i);
+        });
+        MemoryFootprint fp = m->memoryFootprint();
+        double destroyMs = timeMs([&]{ delete m; });
+        cout << "  " << left << setw(16) << name << right << fixed << setprecision(1)
+             << setw(12) << insertMs << setw(18) << churnMs << setw(12) << destroyMs
+             << setw(14) << (double)(fp.tableBytes + fp.entryBytes + fp.slackBytes) / n
+             << (fp.estimated ? " (est.)" : "") << "\n";
+    };
+    run("std::allocator", (HashMap<int,int>*)nullptr);
+    run("SlabAllocator",  (HashMap<int,int,Chaining,SlabAllocator<char>>*)nullptr);
+}
+
+// Word-count throughput on a generated corpus file (skewed word choice)
+void benchmarkParallelWordFrequency(size_t megabytes) {
+    string path = (filesystem::temp_directory_path() / "hashmap_wordfreq_bench.txt").string();
+    {
+        vector<string> vocab;
+        uint64_t x = 88172645463325252ULL;
+        auto next = [&]{ x ^= x << 13; x ^= x >> 7; x ^= x << 17; return x; };
+        for (int i = 0; i < 50000; i++) {
+            string w;
+            for (size_t len = 3 + next() % 8; len > 0; len--) w += (char)('a' + next() % 26);
+            vocab.push_back(w);
+        }
+        ofstream out(path, ios::binary);
+        string line;
+        for (size_t written = 0; written < megabytes << 20; written += line.size()) {
+            line.clear();
+            for (int i = 0; i < 16; i++) {
+                double u = (double)(next() % 1000000) / 1000000;
+                line += vocab[(size_t)(u * u * u * vocab.size())];   // low indexes dominate
+                line += (i % 5 == 4) ? ", " : " ";
+            }
+            line += ".\n";
+            out << line;
+        }
+    }
+    // "per-thread GB/s" divides the corpus by the CPU time all counting tasks
+    // used, so it stays comparable when threads outnumber hardware threads
+    MappedFile file(path);
+    cout << "corpus: " << file.size() / (1 << 20) << " MB, 50000-word vocabulary, "
+         << thread::hardware_concurrency() << " hardware thread(s)\n";
+    cout << "  " << left << setw(9) << "threads" << right << setw(10) << "ms" << setw(10) << "GB/s"
+         << setw(11) << "count ms" << setw(11) << "merge ms" << setw(16) << "per-thread GB/s"
+         << setw(12) << "distinct" << "\n";
+    size_t distinct = 0;
+    for (int threads : {1, 2, 4, 8}) {
+        WorkerPool pool(threads);
+        PipelineTiming phase;
+        double ms = timeMs([&]{ distinct = parallelWordFrequency(file.view(), pool, &phase).size(); });
+        cout << "  " << left << setw(9) << threads << right << fixed << setprecision(1) << setw(10) << ms
+             << setprecision(3) << setw(10) << file.size() / ms / 1e6
+             << setprecision(1) << setw(11) << phase.countMs << setw(11) << phase.mergeMs
+             << setprecision(3) << setw(16) << file.size() / phase.countCpuMs / 1e6
+             << setw(12) << distinct << "\n";
+    }
+    auto top = topK(parallelWordFrequency(file.view(), 4), 5);
+    cout << "  top-5:";
+    for (auto& [w, n] : top) cout << " " << w << "(" << n << ")";
+    cout << "\n";
+    filesystem::remove(path);
+}
+
+// Cold start: rebuild with put() vs mapImage() + first lookup, then lookup cost
+template<typename K, typename MakeKey>
+void benchmarkImage(const string& label, size_t n, MakeKey makeKey) {
+    string path = (filesystem::temp_directory_path() / "hashmap_image_bench.bin").string();
+    vector<K> keys(n);
+    for (size_t i = 0; i < n; i++) keys[i] = makeKey(i);
+    long long sink = 0;
+
+    HashMap<K,int> built(8);
+    built.setRehashLogging(false);
+    double buildMs = timeMs([&]{ for (size_t i = 0; i < n; i++) built.put(keys[i], (int)i); });
+    double saveMs  = timeMs([&]{ built.saveImage(path); });
+    double getMs   = timeMs([&]{ for (const auto& k : keys) sink += built.getOrDefault(k, 0); });
+
+    double mapMs = 0, imgGetMs = 0;
+    size_t fileBytes = 0;
+    {
+        mapMs = timeMs([&]{
+            auto img = HashMap<K,int>::mapImage(path);
+            sink += img.getOrDefault(keys[n / 2], 0);
+            fileBytes = img.fileBytes();
+        });
+        auto img = HashMap<K,int>::mapImage(path);
+        imgGetMs = timeMs([&]{ for (const auto& k : keys) sink += img.getOrDefault(k, 0); });
+    }
+    filesystem::remove(path);
+
+    cout << label << ", n=" << n << ", image " << fileBytes / 1024 << " KB\n" << fixed;
+    cout << "  rebuild with put()     : " << setprecision(1) << buildMs << " ms\n";
+    cout << "  saveImage()            : " << saveMs << " ms\n";
+    cout << "  mapImage() + 1 lookup  : " << setprecision(3) << mapMs << " ms\n";
+    cout << "  get (HashMap / image)  : " << setprecision(1) << getMs * 1e6 / n << " / "
+         << imgGetMs * 1e6 / n << " ns/op (image pass includes first-touch page faults)\n";
+    cout << "  (checksum " << sink << ")\n";
+}
+
 void sep(const string& t) {
     cout << "\n" << string(52, '-') << "\n " << t << "\n" << string(52, '-') << "\n";
 }
@@ -293,5 +2130,113 @@ int main() {
         cout << "]\n";
     }
 
+    sep("11. Open Addressing (Swiss table) backend");
+    HashMap<string,int,OpenAddressing> swissMap;
+    for (const auto& w : words) swissMap[w]++;
+    swissMap.put("eat", 10);
+    swissMap.remove("bat");
+    cout << "Map: "; swissMap.printAll();
+    cout << "contains(bat) = " << (swissMap.contains("bat") ? "YES" : "NO") << "\n";
+    HashMap<int,int,OpenAddressing> swissInts;
+    for (int i = 0; i < 200; i++) swissInts.put(i * 7 % 1000, i);
+    for (int i = 0; i < 100; i++) swissInts.remove(i * 14 % 1000);
+    swissInts.printStats();
+
+    sep("12. Benchmark: chained vs swiss vs std::unordered_map");
+    benchmarkBackends<int>("int keys", 1000000,
+        [](size_t i){ return (int)(uint32_t)(i * 2654435761u); });
+    benchmarkBackends<string>("string keys", 300000,
+        [](size_t i){ return "key:" + to_string(i * 2654435761u % 1000000007u); });
+
+    sep("13. Incremental Rehashing");
+    HashMap<int,string> incMap(4, 0.75f);
+    incMap.setIncrementalRehash(true, 2);
+    for (int i = 0; i < 14; i++) incMap.put(i, "val" + to_string(i));
+    incMap.printStats();
+    cout << "get(3) = " << incMap.get(3) << ", contains(12) = "
+         << (incMap.contains(12) ? "YES" : "NO") << "\n";
+
+    sep("14. Benchmark: put latency with and without incremental rehash");
+    benchmarkPutLatency(2000000);
+
+    sep("15. ConcurrentHashMap (sharded, lock-free reads)");
+    ConcurrentHashMap<string,int> shared(4);
+    vector<thread> writers;
+    for (int t = 0; t < 4; t++)
+        writers.emplace_back([&shared, t]{
+            for (int i = 0; i < 1000; i++) shared.put("w" + to_string(t) + ":" + to_string(i), i);
+            for (int i = 0; i < 1000; i += 2) shared.remove("w" + to_string(t) + ":" + to_string(i));
+        });
+    for (auto& th : writers) th.join();
+    cout << "4 writers x (1000 put, 500 remove): size = " << shared.size() << "\n";
+    cout << "get(w2:999) = " << shared.get("w2:999") << ", contains(w2:998) = "
+         << (shared.contains("w2:998") ? "YES" : "NO") << "\n";
+    shared.printStats();
+
+    sep("16. Benchmark: ConcurrentHashMap throughput vs thread count");
+    benchmarkConcurrent(400000, 100000);
+
+    sep("17. Heterogeneous lookup and try_emplace / insert_or_assign");
+    string buffer = "GET /index.html 200";
+    string_view verb = string_view(buffer).substr(0, 3);
+    HashMap<string,int> methods;
+    methods.put("GET", 1); methods.put("POST", 2);
+    cout << "get(string_view \"" << verb << "\") = " << methods.get(verb)
+         << ", contains(\"PUT\") = " << (methods.contains("PUT") ? "YES" : "NO") << "\n";
+    auto [slot, inserted] = methods.try_emplace("PUT", 3);
+    cout << "try_emplace(PUT, 3)  -> value " << *slot << ", inserted = " << boolalpha << inserted << "\n";
+    auto [slot2, inserted2] = methods.try_emplace("PUT", 99);
+    cout << "try_emplace(PUT, 99) -> value " << *slot2 << ", inserted = " << inserted2 << "\n";
+    cout << "insert_or_assign(GET, 10) -> inserted = " << methods.insert_or_assign("GET", 10)
+         << ", GET = " << methods.get("GET") << noboolalpha << "\n";
+
+    sep("18. Slab allocator for chain nodes");
+    HashMap<int,int,Chaining,SlabAllocator<char>> slabMap(64);
+    for (int i = 0; i < 40; i++) slabMap.put(i, i * i);
+    for (int i = 0; i < 40; i += 4) slabMap.remove(i);
+    slabMap.printStats();
+    cout << "\nSame data, std::allocator:\n";
+    HashMap<int,int> plainMap(64);
+    for (int i = 0; i < 40; i++) plainMap.put(i, i * i);
+    for (int i = 0; i < 40; i += 4) plainMap.remove(i);
+    plainMap.printStats();
+
+    sep("19. Benchmark: std::allocator vs SlabAllocator");
+    benchmarkAllocators(2000000);
+
+    sep("20. Parallel word frequency, top-K and group anagrams");
+    string corpus = "the quick brown fox jumps over the lazy dog the fox "
+                    "The DOG sleeps; the fox runs. A quick dog, a lazy fox!";
+    auto pfreq = parallelWordFrequency(corpus, 3);
+    auto sfreq = wordFrequency(corpus);
+    bool same = pfreq.size() == sfreq.size();
+    sfreq.forEach([&](const string& w, const int& n){ same = same && pfreq.getOrDefault(w, 0) == n; });
+    cout << "3 threads: " << pfreq.size() << " distinct words, matches wordFrequency(): "
+         << (same ? "YES" : "NO") << "\n";
+    cout << "top-3:";
+    for (auto& [w, n] : topK(pfreq, 3)) cout << " " << w << "(" << n << ")";
+    cout << "\n";
+    auto pgroups = parallelGroupAnagrams(words, 3);
+    cout << "parallelGroupAnagrams(3 threads): " << pgroups.size() << " groups\n";
+
+    sep("21. Benchmark: parallel word frequency throughput");
+    benchmarkParallelWordFrequency(32);
+
+    sep("22. Memory-mappable image (saveImage / mapImage)");
+    string imgPath = (filesystem::temp_directory_path() / "hashmap_demo.img").string();
+    freq.saveImage(imgPath);
+    auto freqImg = HashMap<string,int>::mapImage(imgPath);
+    cout << "Saved word frequencies: " << freqImg.size() << " words, "
+         << freqImg.fileBytes() << " bytes\n";
+    cout << "the=" << freqImg.get("the") << " fox=" << freqImg.get("fox")
+         << " cat=" << freqImg.getOrDefault("cat", 0) << "\n";
+    try { HashMap<int,int>::mapImage(imgPath); }
+    catch (const runtime_error& e) { cout << "Opening as <int,int>: " << e.what() << "\n"; }
+    filesystem::remove(imgPath);
+
+    sep("23. Benchmark: rebuild vs mapImage cold start");
+    benchmarkImage<int>("int keys", 1000000, [](size_t i){ return (int)(uint32_t)(i * 2654435761u); });
+    benchmarkImage<string>("string keys", 300000, [](size_t i){ return "key:" + to_string(i); });
+
     return 0;
 }
\ No newline at end of file
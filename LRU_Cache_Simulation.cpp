@@ -1,6 +1,23 @@
 #include <iostream>
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <iomanip>
+#include <list>
+#include <fstream>
+#include <stdexcept>
+#include <cstdint>
+#include <atomic>
+#include <future>
+#include <condition_variable>
 using namespace std;
 
 // Node for doubly linked list
@@ -20,6 +37,7 @@ class LRUCache {
 private:
     int capacity;
     int size;
+    bool verbose;  // print every hit/miss/insert/eviction
     unordered_map<K, Node<K, V>*> cache;
     Node<K, V>* head;  // Most recently used
     Node<K, V>* tail;  // Least recently used
@@ -52,7 +70,7 @@ private:
     }
     
 public:
-    LRUCache(int cap) : capacity(cap), size(0) {
+    LRUCache(int cap, bool verbose = true) : capacity(cap), size(0), verbose(verbose) {
         head = new Node<K, V>(K(), V());
         tail = new Node<K, V>(K(), V());
         head->next = tail;
@@ -70,15 +88,24 @@ public:
     
     // Get value by key, returns default V() if not found
     V get(K key) {
-        if (cache.find(key) == cache.end()) {
-            cout << "Cache MISS: " << key << endl;
-            return V();  // Not found
+        V value = V();
+        tryGet(key, value);
+        return value;
+    }
+    
+    // Get value by key into out; returns false on a miss
+    bool tryGet(const K& key, V& out) {
+        auto it = cache.find(key);
+        if (it == cache.end()) {
+            if (verbose) cout << "Cache MISS: " << key << endl;
+            return false;
         }
         
-        Node<K, V>* node = cache[key];
+        Node<K, V>* node = it->second;
         moveToHead(node);  // Mark as recently used
-        cout << "Cache HIT: " << key << " -> " << node->value << endl;
-        return node->value;
+        if (verbose) cout << "Cache HIT: " << key << " -> " << node->value << endl;
+        out = node->value;
+        return true;
     }
     
     // Insert or update key-value pair
@@ -88,7 +115,7 @@ public:
             Node<K, V>* node = cache[key];
             node->value = value;
             moveToHead(node);
-            cout << "Updated: " << key << " = " << value << endl;
+            if (verbose) cout << "Updated: " << key << " = " << value << endl;
         } else {
             // Insert new key
             Node<K, V>* newNode = new Node<K, V>(key, value);
@@ -96,17 +123,17 @@ public:
             addNode(newNode);
             size++;
             
-            cout << "Inserted: " << key << " = " << value;
+            if (verbose) cout << "Inserted: " << key << " = " << value;
             
             // Evict LRU if over capacity
             if (size > capacity) {
                 Node<K, V>* lru = removeTail();
                 cache.erase(lru->key);
-                cout << " | Evicted LRU: " << lru->key;
+                if (verbose) cout << " | Evicted LRU: " << lru->key;
                 delete lru;
                 size--;
             }
-            cout << endl;
+            if (verbose) cout << endl;
         }
     }
     
@@ -135,8 +162,1283 @@ public:
     int getCapacity() { return capacity; }
 };
 
+// Thread-safe LRU cache: keys are hashed into independent shards, each an
+// LRUCache with its own lock and recency list. get/put stay O(1) and only
+// contend when two threads hit the same shard. Recency is tracked per
+// shard, so eviction is LRU within a shard rather than globally.
+template <typename K, typename V>
+class ShardedLRUCache {
+private:
+    struct Shard {
+        mutex lock;
+        LRUCache<K, V> cache;
+        Shard(int cap) : cache(cap, false) {}
+    };
+    
+    vector<unique_ptr<Shard>> shards;
+    int capacity;
+    
+    Shard& shardFor(const K& key) {
+        return *shards[hash<K>{}(key) % shards.size()];
+    }
+    
+public:
+    // Total capacity is split evenly (rounded up) across the shards
+    ShardedLRUCache(int cap, int numShards = 16) : capacity(cap) {
+        numShards = max(numShards, 1);
+        int perShard = max(1, (cap + numShards - 1) / numShards);
+        for (int i = 0; i < numShards; i++) shards.push_back(make_unique<Shard>(perShard));
+    }
+    
+    // Get value by key, returns default V() if not found
+    V get(const K& key) {
+        V value = V();
+        tryGet(key, value);
+        return value;
+    }
+    
+    bool tryGet(const K& key, V& out) {
+        Shard& s = shardFor(key);
+        lock_guard<mutex> lk(s.lock);
+        return s.cache.tryGet(key, out);
+    }
+    
+    void put(const K& key, const V& value) {
+        Shard& s = shardFor(key);
+        lock_guard<mutex> lk(s.lock);
+        s.cache.put(key, value);
+    }
+    
+    bool contains(const K& key) {
+        Shard& s = shardFor(key);
+        lock_guard<mutex> lk(s.lock);
+        return s.cache.contains(key);
+    }
+    
+    int getSize() {
+        int total = 0;
+        for (auto& s : shards) {
+            lock_guard<mutex> lk(s->lock);
+            total += s->cache.getSize();
+        }
+        return total;
+    }
+    
+    int getCapacity() { return capacity; }
+    int getShardCount() { return (int)shards.size(); }
+};
+
+// Zipfian key generator over [0, n): P(k) ~ 1 / (k+1)^s
+class ZipfGenerator {
+private:
+    vector<double> cdf;
+    mt19937_64 rng;
+    uniform_real_distribution<double> uniform;
+    
+public:
+    ZipfGenerator(int n, double s, uint64_t seed) : cdf(n), rng(seed), uniform(0.0, 1.0) {
+        double sum = 0;
+        for (int k = 0; k < n; k++) cdf[k] = (sum += 1.0 / pow(k + 1, s));
+        for (auto& c : cdf) c /= sum;
+    }
+    
+    int next() {
+        return (int)(lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin());
+    }
+};
+
+// Cache-aside workload (get, put on miss) over Zipfian keys: one global
+// mutex around LRUCache vs ShardedLRUCache, 1..16 threads
+void benchmarkShardedLRU(int keySpace, int capacity, int opsPerThread) {
+    cout << "\n=== Benchmark: " << keySpace << " keys, capacity " << capacity
+         << ", " << opsPerThread << " ops/thread ===" << endl;
+    cout << left << setw(8) << "theta" << setw(9) << "threads"
+         << right << setw(14) << "global Mops" << setw(10) << "hit %"
+         << setw(15) << "sharded Mops" << setw(10) << "hit %" << endl;
+    
+    for (double theta : {0.8, 0.99}) {
+        for (int threads : {1, 2, 4, 8, 16}) {
+            vector<vector<int>> traces(threads);
+            for (int t = 0; t < threads; t++) {
+                ZipfGenerator zipf(keySpace, theta, 42 + t);
+                for (int i = 0; i < opsPerThread; i++) traces[t].push_back(zipf.next());
+            }
+            
+            // Returns {Mops/s, hit ratio}
+            auto run = [&](function<bool(int)> lookupOrFill) {
+                vector<long long> hits(threads, 0);
+                vector<thread> pool;
+                auto start = chrono::steady_clock::now();
+                for (int t = 0; t < threads; t++) {
+                    pool.emplace_back([&, t]() {
+                        for (int key : traces[t]) hits[t] += lookupOrFill(key);
+                    });
+                }
+                for (auto& th : pool) th.join();
+                double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                long long totalHits = 0;
+                for (long long h : hits) totalHits += h;
+                double ops = (double)threads * opsPerThread;
+                return make_pair(ops / sec / 1e6, 100.0 * totalHits / ops);
+            };
+            
+            LRUCache<int, int> global(capacity, false);
+            mutex globalLock;
+            auto g = run([&](int key) {
+                lock_guard<mutex> lk(globalLock);
+                int v;
+                if (global.tryGet(key, v)) return true;
+                global.put(key, key);
+                return false;
+            });
+            
+            ShardedLRUCache<int, int> sharded(capacity, 16);
+            auto s = run([&](int key) {
+                int v;
+                if (sharded.tryGet(key, v)) return true;
+                sharded.put(key, key);
+                return false;
+            });
+            
+            cout << fixed << setprecision(2) << left << setw(8) << theta << setw(9) << threads
+                 << right << setw(14) << g.first << setw(10) << g.second
+                 << setw(15) << s.first << setw(10) << s.second << endl;
+        }
+    }
+    cout << "(hardware threads: " << thread::hardware_concurrency() << ")" << endl;
+}
+
+// ---------------------------------------------------------------------------
+// Production LRU: intrusive node pool, silent hot path
+// ---------------------------------------------------------------------------
+// Counters readable from any thread while the cache runs
+struct CacheStats {
+    uint64_t hits = 0, misses = 0, evictions = 0, expirations = 0;
+    double hitRate() const {
+        return hits + misses ? (double)hits / (hits + misses) : 0.0;
+    }
+};
+
+// All `capacity` nodes are allocated up front and linked by index; the key
+// index is an open-addressing table of node indices (linear probing with
+// backward-shift deletion), so get/put never allocate and a lookup is one
+// probe sequence. Nothing is printed: hits, misses and evictions go to
+// atomic counters instead. Not thread-safe (one writer), but stats() may
+// be called from another thread.
+template <typename K, typename V>
+class IntrusiveLRUCache {
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    
+    struct Slot {
+        K key;
+        V value;
+        size_t hash;
+        uint32_t prev, next;
+    };
+    
+    uint32_t capacity;
+    uint32_t used;            // pool nodes handed out so far
+    vector<Slot> nodes;       // [0, capacity) entries, [capacity] = list sentinel
+    vector<uint32_t> index;   // node index per table slot, NIL = empty
+    size_t mask;
+    atomic<uint64_t> hits, misses, evictions;
+    
+    // Single writer: a relaxed load+store is enough and avoids a locked add
+    static void bump(atomic<uint64_t>& c) {
+        c.store(c.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+    
+    uint32_t sentinel() const { return capacity; }
+    
+    // std::hash<int> is the identity; scramble it so linear probing
+    // does not build long runs out of consecutive keys
+    static size_t hashOf(const K& key) {
+        uint64_t h = hash<K>{}(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return (size_t)h;
+    }
+    
+    void unlink(uint32_t n) {
+        nodes[nodes[n].prev].next = nodes[n].next;
+        nodes[nodes[n].next].prev = nodes[n].prev;
+    }
+    
+    void linkFront(uint32_t n) {
+        uint32_t s = sentinel();
+        nodes[n].prev = s;
+        nodes[n].next = nodes[s].next;
+        nodes[nodes[s].next].prev = n;
+        nodes[s].next = n;
+    }
+    
+    // Slot holding key, or the empty slot where it would go
+    size_t probe(const K& key, size_t h, bool& found) const {
+        size_t i = h & mask;
+        while (index[i] != NIL) {
+            const Slot& n = nodes[index[i]];
+            if (n.hash == h && n.key == key) { found = true; return i; }
+            i = (i + 1) & mask;
+        }
+        found = false;
+        return i;
+    }
+    
+    // Remove node n from the index, shifting later cluster entries back
+    void eraseIndex(uint32_t n) {
+        size_t i = nodes[n].hash & mask;
+        while (index[i] != n) i = (i + 1) & mask;
+        for (size_t j = i;;) {
+            j = (j + 1) & mask;
+            if (index[j] == NIL) break;
+            size_t home = nodes[index[j]].hash & mask;
+            // Move j into the hole unless its home lies cyclically in (i, j]
+            bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays) { index[i] = index[j]; i = j; }
+        }
+        index[i] = NIL;
+    }
+    
+public:
+    IntrusiveLRUCache(int cap)
+        : capacity((uint32_t)max(cap, 1)), used(0), nodes(capacity + 1),
+          hits(0), misses(0), evictions(0) {
+        size_t tableSize = 2;
+        while (tableSize < 2 * (size_t)capacity) tableSize <<= 1;
+        index.assign(tableSize, NIL);
+        mask = tableSize - 1;
+        nodes[sentinel()].prev = nodes[sentinel()].next = sentinel();
+    }
+    
+    bool tryGet(const K& key, V& out) {
+        bool found;
+        size_t i = probe(key, hashOf(key), found);
+        if (!found) { bump(misses); return false; }
+        uint32_t n = index[i];
+        unlink(n);
+        linkFront(n);
+        bump(hits);
+        out = nodes[n].value;
+        return true;
+    }
+    
+    // Get value by key, returns default V() if not found
+    V get(const K& key) {
+        V value = V();
+        tryGet(key, value);
+        return value;
+    }
+    
+    void put(const K& key, const V& value) {
+        size_t h = hashOf(key);
+        bool found;
+        size_t i = probe(key, h, found);
+        if (found) {
+            uint32_t n = index[i];
+            nodes[n].value = value;
+            unlink(n);
+            linkFront(n);
+            return;
+        }
+        uint32_t n;
+        if (used < capacity) {
+            n = used++;
+        } else {
+            // Recycle the LRU node; its index removal may shift our slot
+            n = nodes[sentinel()].prev;
+            unlink(n);
+            eraseIndex(n);
+            bump(evictions);
+            i = probe(key, h, found);
+        }
+        nodes[n].key = key;
+        nodes[n].value = value;
+        nodes[n].hash = h;
+        index[i] = n;
+        linkFront(n);
+    }
+    
+    bool contains(const K& key) const {
+        bool found;
+        probe(key, hashOf(key), found);
+        return found;
+    }
+    
+    CacheStats stats() const {
+        CacheStats s;
+        s.hits = hits.load(memory_order_relaxed);
+        s.misses = misses.load(memory_order_relaxed);
+        s.evictions = evictions.load(memory_order_relaxed);
+        return s;
+    }
+    
+    void resetStats() {
+        hits.store(0, memory_order_relaxed);
+        misses.store(0, memory_order_relaxed);
+        evictions.store(0, memory_order_relaxed);
+    }
+    
+    int getSize() const { return (int)used; }
+    int getCapacity() const { return (int)capacity; }
+    
+    // Keys from most to least recently used
+    vector<K> keysByRecency() const {
+        vector<K> keys;
+        for (uint32_t n = nodes[sentinel()].next; n != sentinel(); n = nodes[n].next)
+            keys.push_back(nodes[n].key);
+        return keys;
+    }
+};
+
+// Discards everything written to it (times the verbose LRUCache without a terminal)
+struct NullBuffer : streambuf {
+    int overflow(int c) override { return c; }
+};
+
+// ns per cache-aside access: LRUCache (printing / quiet) vs IntrusiveLRUCache
+void benchmarkIntrusiveLRU(int keySpace, int capacity, int ops) {
+    ZipfGenerator zipf(keySpace, 0.99, 11);
+    vector<int> trace(ops);
+    for (auto& k : trace) k = zipf.next();
+    
+    cout << "\n=== Benchmark: " << ops << " Zipfian accesses, " << keySpace
+         << " keys, capacity " << capacity << " ===" << endl;
+    auto report = [&](const string& name, function<bool(int)> access) {
+        long long hits = 0;
+        auto start = chrono::steady_clock::now();
+        for (int key : trace) hits += access(key);
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        cout << left << setw(30) << name << right << fixed << setprecision(1)
+             << setw(10) << ns / ops << " ns/op" << setw(10) << 100.0 * hits / ops << " % hits" << endl;
+    };
+    
+    {
+        LRUCache<int, int> cache(capacity);
+        NullBuffer nullBuf;
+        streambuf* saved = cout.rdbuf(&nullBuf);
+        long long hits = 0;
+        auto start = chrono::steady_clock::now();
+        for (int key : trace) {
+            int v;
+            if (cache.tryGet(key, v)) hits++;
+            else cache.put(key, key);
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        cout.rdbuf(saved);
+        cout << left << setw(30) << "LRUCache (logging to null)" << right << fixed << setprecision(1)
+             << setw(10) << ns / ops << " ns/op" << setw(10) << 100.0 * hits / ops << " % hits" << endl;
+    }
+    LRUCache<int, int> quiet(capacity, false);
+    report("LRUCache (quiet)", [&](int key) {
+        int v;
+        if (quiet.tryGet(key, v)) return true;
+        quiet.put(key, key);
+        return false;
+    });
+    IntrusiveLRUCache<int, int> pooled(capacity);
+    report("IntrusiveLRUCache", [&](int key) {
+        int v;
+        if (pooled.tryGet(key, v)) return true;
+        pooled.put(key, key);
+        return false;
+    });
+    CacheStats st = pooled.stats();
+    cout << "IntrusiveLRUCache stats: hits=" << st.hits << " misses=" << st.misses
+         << " evictions=" << st.evictions << " hit rate=" << setprecision(3) << st.hitRate() << endl;
+}
+
+// ---------------------------------------------------------------------------
+// Size-aware, TTL-expiring LRU with a hierarchical timer wheel
+// ---------------------------------------------------------------------------
+// Intrusive timer link, embedded in each expiring entry
+struct TimerNode {
+    TimerNode* timerPrev = nullptr;
+    TimerNode* timerNext = nullptr;
+    uint64_t expireAt = 0;   // absolute ms, 0 = never
+    uint8_t level = 0, slot = 0;
+    bool scheduled() const { return timerPrev != nullptr; }
+};
+
+// 4 levels x 64 slots with 1 ms ticks (span ~4.6 hours; later deadlines park
+// in the top level and are re-cascaded). Each level keeps an occupancy bitmap
+// so advance() jumps straight to the next non-empty slot instead of ticking.
+class TimerWheel {
+private:
+    static constexpr int kBits = 6, kSlots = 1 << kBits, kLevels = 4;
+    static constexpr uint64_t kSpan = 1ULL << (kBits * kLevels);
+    
+    TimerNode heads[kLevels][kSlots];   // circular list sentinels
+    uint64_t occupied[kLevels];
+    uint64_t current;
+    size_t count;
+    
+    void place(TimerNode* t) {
+        uint64_t at = max(t->expireAt, current);
+        uint64_t delta = at - current;
+        if (delta >= kSpan) at = current + kSpan - 1;
+        int level = 0;
+        while (level < kLevels - 1 && delta >= (1ULL << (kBits * (level + 1)))) level++;
+        int s = (at >> (kBits * level)) & (kSlots - 1);
+        TimerNode& head = heads[level][s];
+        t->timerPrev = &head;
+        t->timerNext = head.timerNext;
+        head.timerNext->timerPrev = t;
+        head.timerNext = t;
+        t->level = (uint8_t)level;
+        t->slot = (uint8_t)s;
+        occupied[level] |= 1ULL << s;
+        count++;
+    }
+    
+    // Detach a whole slot and hand each timer to fn
+    template <typename F>
+    void drain(int level, int s, F fn) {
+        TimerNode& head = heads[level][s];
+        if (head.timerNext == &head) return;
+        TimerNode* t = head.timerNext;
+        head.timerPrev->timerNext = nullptr;
+        head.timerPrev = head.timerNext = &head;
+        occupied[level] &= ~(1ULL << s);
+        while (t) {
+            TimerNode* nxt = t->timerNext;
+            t->timerPrev = t->timerNext = nullptr;
+            count--;
+            fn(t);
+            t = nxt;
+        }
+    }
+    
+    // At a level-0 rollover, pull the due slot of each higher level down
+    void cascade() {
+        int top = 1;
+        while (top < kLevels - 1 && ((current >> (kBits * top)) & (kSlots - 1)) == 0) top++;
+        for (int level = top; level >= 1; level--) {
+            int s = (current >> (kBits * level)) & (kSlots - 1);
+            drain(level, s, [this](TimerNode* t) { place(t); });
+        }
+    }
+    
+public:
+    explicit TimerWheel(uint64_t now = 0) : current(now), count(0) {
+        for (auto& level : heads)
+            for (auto& head : level) head.timerPrev = head.timerNext = &head;
+        fill(begin(occupied), end(occupied), 0);
+    }
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    
+    void schedule(TimerNode* t, uint64_t expireAt) {
+        if (t->scheduled()) cancel(t);
+        t->expireAt = expireAt;
+        place(t);
+    }
+    
+    void cancel(TimerNode* t) {
+        if (!t->scheduled()) return;
+        t->timerPrev->timerNext = t->timerNext;
+        t->timerNext->timerPrev = t->timerPrev;
+        TimerNode& head = heads[t->level][t->slot];
+        if (head.timerNext == &head) occupied[t->level] &= ~(1ULL << t->slot);
+        t->timerPrev = t->timerNext = nullptr;
+        count--;
+    }
+    
+    // Move time forward to now, calling onExpire(t) for every due timer
+    template <typename F>
+    void advance(uint64_t now, F onExpire) {
+        while (current < now && count > 0) {
+            uint64_t base = current & ~(uint64_t)(kSlots - 1);
+            uint64_t next = base + kSlots;
+            int s = current & (kSlots - 1);
+            uint64_t later = s + 1 < kSlots ? occupied[0] & (~0ULL << (s + 1)) : 0;
+            if (later) next = base + __builtin_ctzll(later);
+            if (next > now) break;
+            current = next;
+            if ((current & (kSlots - 1)) == 0) cascade();
+            drain(0, current & (kSlots - 1), [&](TimerNode* t) {
+                if (t->expireAt <= current) onExpire(t);
+                else place(t);
+            });
+        }
+        if (current < now) current = now;
+    }
+    
+    size_t size() const { return count; }
+};
+
+// LRU bounded by total weight (e.g. bytes) instead of entry count, with an
+// optional per-entry TTL. Expired entries are removed by the timer wheel as
+// time advances, so neither expiry nor eviction scans the list.
+template <typename K, typename V>
+class ExpiringLRUCache {
+public:
+    using Weigher = function<size_t(const K&, const V&)>;
+    using Clock = function<uint64_t()>;   // milliseconds
+    
+    static uint64_t steadyMillis() {
+        return chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+private:
+    struct Entry : TimerNode {
+        K key;
+        V value;
+        size_t weight = 0;
+        Entry* lruPrev = nullptr;
+        Entry* lruNext = nullptr;
+    };
+    
+    size_t maxWeight;
+    size_t totalWeight;
+    uint64_t defaultTtl;
+    Weigher weigher;
+    Clock clock;
+    unordered_map<K, Entry*> cache;
+    Entry* head;   // most recently used side
+    Entry* tail;
+    TimerWheel wheel;
+    uint64_t hits, misses, evictions, expirations;
+    
+    void unlink(Entry* e) {
+        e->lruPrev->lruNext = e->lruNext;
+        e->lruNext->lruPrev = e->lruPrev;
+    }
+    
+    void linkFront(Entry* e) {
+        e->lruNext = head->lruNext;
+        e->lruPrev = head;
+        head->lruNext->lruPrev = e;
+        head->lruNext = e;
+    }
+    
+    void destroy(Entry* e) {
+        unlink(e);
+        wheel.cancel(e);
+        totalWeight -= e->weight;
+        cache.erase(e->key);
+        delete e;
+    }
+    
+    uint64_t expireDue() {
+        uint64_t now = clock();
+        wheel.advance(now, [this](TimerNode* t) {
+            expirations++;
+            destroy(static_cast<Entry*>(t));
+        });
+        return now;
+    }
+    
+public:
+    ExpiringLRUCache(size_t maxWeight, Weigher weigher = nullptr,
+                     uint64_t defaultTtlMs = 0, Clock clock = steadyMillis)
+        : maxWeight(maxWeight), totalWeight(0), defaultTtl(defaultTtlMs),
+          weigher(weigher ? weigher : [](const K&, const V&) { return (size_t)1; }),
+          clock(clock), wheel(this->clock()),
+          hits(0), misses(0), evictions(0), expirations(0) {
+        head = new Entry();
+        tail = new Entry();
+        head->lruNext = tail;
+        tail->lruPrev = head;
+    }
+    
+    ~ExpiringLRUCache() {
+        Entry* cur = head;
+        while (cur) {
+            Entry* nxt = cur->lruNext;
+            delete cur;
+            cur = nxt;
+        }
+    }
+    
+    ExpiringLRUCache(const ExpiringLRUCache&) = delete;
+    ExpiringLRUCache& operator=(const ExpiringLRUCache&) = delete;
+    
+    bool tryGet(const K& key, V& out) {
+        expireDue();
+        auto it = cache.find(key);
+        if (it == cache.end()) { misses++; return false; }
+        Entry* e = it->second;
+        unlink(e);
+        linkFront(e);
+        hits++;
+        out = e->value;
+        return true;
+    }
+    
+    // Insert or update with a TTL in ms (0 = cache default, which may be "never").
+    // Returns false if the entry alone outweighs the whole cache.
+    bool put(const K& key, const V& value, uint64_t ttlMs = 0) {
+        uint64_t now = expireDue();
+        size_t w = weigher(key, value);
+        auto it = cache.find(key);
+        if (w > maxWeight) {
+            if (it != cache.end()) destroy(it->second);
+            return false;
+        }
+        Entry* e;
+        if (it != cache.end()) {
+            e = it->second;
+            totalWeight -= e->weight;
+            e->value = value;
+            unlink(e);
+        } else {
+            e = new Entry();
+            e->key = key;
+            e->value = value;
+            cache[key] = e;
+        }
+        e->weight = w;
+        totalWeight += w;
+        linkFront(e);
+        
+        uint64_t ttl = ttlMs ? ttlMs : defaultTtl;
+        if (ttl) wheel.schedule(e, now + ttl);
+        else wheel.cancel(e);
+        
+        while (totalWeight > maxWeight) {
+            evictions++;
+            destroy(tail->lruPrev);
+        }
+        return true;
+    }
+    
+    bool remove(const K& key) {
+        auto it = cache.find(key);
+        if (it == cache.end()) return false;
+        destroy(it->second);
+        return true;
+    }
+    
+    // Expire everything due by now; returns how many entries were dropped
+    size_t cleanUp() {
+        uint64_t before = expirations;
+        expireDue();
+        return (size_t)(expirations - before);
+    }
+    
+    void display() const {
+        cout << "Cache (MRU -> LRU): ";
+        for (Entry* cur = head->lruNext; cur != tail; cur = cur->lruNext) {
+            cout << "[" << cur->key << ":" << cur->weight << "B";
+            if (cur->expireAt) cout << " exp@" << cur->expireAt;
+            cout << "] ";
+        }
+        cout << "| " << totalWeight << "/" << maxWeight << " bytes" << endl;
+    }
+    
+    CacheStats stats() const {
+        CacheStats s;
+        s.hits = hits;
+        s.misses = misses;
+        s.evictions = evictions;
+        s.expirations = expirations;
+        return s;
+    }
+    
+    int getSize() const { return (int)cache.size(); }
+    size_t getWeight() const { return totalWeight; }
+    size_t getMaxWeight() const { return maxWeight; }
+};
+
+// Churn with random TTLs under a simulated clock; checks nothing stale survives
+void benchmarkExpiringLRU(int ops) {
+    uint64_t fakeNow = 0;
+    ExpiringLRUCache<int, string> cache(
+        4 << 20, [](const int&, const string& v) { return v.size() + sizeof(int); },
+        0, [&] { return fakeNow; });
+    mt19937 rng(5);
+    uniform_int_distribution<int> keyDist(0, 20000), sizeDist(16, 512), ttlDist(1, 120000);
+    
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ops; i++) {
+        fakeNow += rng() % 3;   // ~1 ms per op of simulated time
+        int key = keyDist(rng);
+        string v;
+        if (!cache.tryGet(key, v))
+            cache.put(key, string(sizeDist(rng), 'x'), ttlDist(rng));
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    
+    // Jump past every deadline: the wheel must drain completely
+    fakeNow += 200000;
+    cache.cleanUp();
+    CacheStats st = cache.stats();
+    cout << "\n=== Benchmark: " << ops << " ops, 4 MiB weighted, TTL 1 ms..120 s ===" << endl;
+    cout << fixed << setprecision(1) << ns / ops << " ns/op, hit rate "
+         << setprecision(3) << st.hitRate() << ", evictions " << st.evictions
+         << ", expirations " << st.expirations << ", left after "
+         << "all deadlines: " << cache.getSize() << endl;
+}
+
+// ---------------------------------------------------------------------------
+// Read-through cache with single-flight loading and refresh-ahead
+// ---------------------------------------------------------------------------
+struct LoadStats {
+    uint64_t hits = 0, loads = 0, coalesced = 0, refreshes = 0, failures = 0;
+};
+
+// getOrLoad(key, loader) returns the cached value or runs loader(key) to
+// fetch it. At most one load per key is in flight: concurrent callers for
+// the same key wait on a shared future instead of hitting the backend.
+// Entries expire ttlMs after they were loaded; once older than
+// refreshAfterMs (< ttlMs), the next hit still returns the cached value but
+// starts a background reload so hot keys never expire under load.
+template <typename K, typename V>
+class LoadingLRUCache {
+public:
+    using Loader = function<V(const K&)>;
+    using Clock = typename ExpiringLRUCache<K, int>::Clock;
+    
+private:
+    struct Record {
+        V value;
+        uint64_t refreshAt = 0;
+    };
+    
+    mutex lock;
+    condition_variable idle;
+    ExpiringLRUCache<K, Record> cache;
+    unordered_map<K, shared_future<V>> inFlight;
+    uint64_t ttl, refreshAfter;
+    Clock clock;
+    LoadStats counters;
+    int pendingRefreshes;
+    
+    void store(const K& key, const V& value) {
+        Record rec;
+        rec.value = value;
+        rec.refreshAt = refreshAfter ? clock() + refreshAfter : 0;
+        cache.put(key, rec, ttl);
+    }
+    
+    // Caller holds the lock and has registered the key in inFlight
+    void refreshAsync(const K& key, Loader loader, shared_ptr<promise<V>> done) {
+        pendingRefreshes++;
+        counters.refreshes++;
+        thread([this, key, loader, done] {
+            try {
+                V value = loader(key);
+                lock_guard<mutex> lk(lock);
+                store(key, value);
+                done->set_value(value);
+            } catch (...) {
+                lock_guard<mutex> lk(lock);
+                counters.failures++;   // keep serving the old value until it expires
+                done->set_exception(current_exception());
+            }
+            lock_guard<mutex> lk(lock);
+            inFlight.erase(key);
+            if (--pendingRefreshes == 0) idle.notify_all();
+        }).detach();
+    }
+    
+public:
+    LoadingLRUCache(int capacity, uint64_t ttlMs, uint64_t refreshAfterMs = 0,
+                    Clock clock = ExpiringLRUCache<K, int>::steadyMillis)
+        : cache(capacity, nullptr, ttlMs, clock), ttl(ttlMs),
+          refreshAfter(refreshAfterMs < ttlMs || !ttlMs ? refreshAfterMs : 0),
+          clock(clock), pendingRefreshes(0) {}
+    
+    // Waits for background refreshes, which still reference this cache
+    ~LoadingLRUCache() {
+        unique_lock<mutex> lk(lock);
+        idle.wait(lk, [this] { return pendingRefreshes == 0; });
+    }
+    
+    LoadingLRUCache(const LoadingLRUCache&) = delete;
+    LoadingLRUCache& operator=(const LoadingLRUCache&) = delete;
+    
+    // Loader exceptions propagate to every caller waiting on that load
+    V getOrLoad(const K& key, const Loader& loader) {
+        unique_lock<mutex> lk(lock);
+        Record rec;
+        if (cache.tryGet(key, rec)) {
+            counters.hits++;
+            if (rec.refreshAt && clock() >= rec.refreshAt && !inFlight.count(key)) {
+                auto done = make_shared<promise<V>>();
+                inFlight[key] = done->get_future().share();
+                refreshAsync(key, loader, done);
+            }
+            return rec.value;
+        }
+        
+        auto it = inFlight.find(key);
+        if (it != inFlight.end()) {
+            counters.coalesced++;
+            shared_future<V> pending = it->second;
+            lk.unlock();
+            return pending.get();
+        }
+        
+        // First caller for this key: load outside the lock
+        promise<V> done;
+        inFlight[key] = done.get_future().share();
+        counters.loads++;
+        lk.unlock();
+        try {
+            V value = loader(key);
+            lk.lock();
+            store(key, value);
+            inFlight.erase(key);
+            lk.unlock();
+            done.set_value(value);
+            return value;
+        } catch (...) {
+            if (!lk.owns_lock()) lk.lock();
+            counters.failures++;
+            inFlight.erase(key);
+            lk.unlock();
+            done.set_exception(current_exception());
+            throw;
+        }
+    }
+    
+    LoadStats stats() {
+        lock_guard<mutex> lk(lock);
+        return counters;
+    }
+    
+    int getSize() {
+        lock_guard<mutex> lk(lock);
+        return cache.getSize();
+    }
+};
+
+// Stand-in for a slow backing store: fixed latency, counts every call
+struct SlowBackend {
+    chrono::milliseconds latency;
+    atomic<int> calls;
+    atomic<int> version;   // bumped per call so refreshes are visible
+    
+    SlowBackend(int latencyMs) : latency(latencyMs), calls(0), version(0) {}
+    
+    string fetch(const int& key) {
+        calls++;
+        int v = ++version;
+        this_thread::sleep_for(latency);
+        return "row" + to_string(key) + "@v" + to_string(v);
+    }
+};
+
+// Backend calls for a hot-key burst: cache-aside on ShardedLRUCache vs getOrLoad
+void benchmarkSingleFlight(int threads, int requestsPerThread, int keySpace, int latencyMs) {
+    cout << "\n=== Benchmark: " << threads << " threads x " << requestsPerThread
+         << " requests, " << keySpace << " Zipfian keys, backend " << latencyMs << " ms ===" << endl;
+    auto run = [&](const string& name, function<string(int)> get, SlowBackend& backend) {
+        auto start = chrono::steady_clock::now();
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back([&, t] {
+                ZipfGenerator zipf(keySpace, 0.99, 100 + t);
+                for (int i = 0; i < requestsPerThread; i++) get(zipf.next());
+            });
+        }
+        for (auto& th : pool) th.join();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << left << setw(26) << name << right << setw(8) << backend.calls.load()
+             << " backend calls" << fixed << setprecision(1) << setw(10) << ms << " ms" << endl;
+    };
+    
+    SlowBackend naiveBackend(latencyMs);
+    ShardedLRUCache<int, string> aside(keySpace);
+    run("cache-aside (sharded)", [&](int key) {
+        string v;
+        if (aside.tryGet(key, v)) return v;
+        v = naiveBackend.fetch(key);
+        aside.put(key, v);
+        return v;
+    }, naiveBackend);
+    
+    SlowBackend coalescedBackend(latencyMs);
+    LoadingLRUCache<int, string> loading(keySpace, 60000);
+    auto loader = [&](const int& key) { return coalescedBackend.fetch(key); };
+    run("getOrLoad (single-flight)", [&](int key) { return loading.getOrLoad(key, loader); },
+        coalescedBackend);
+    LoadStats ls = loading.stats();
+    cout << "getOrLoad: hits=" << ls.hits << " loads=" << ls.loads
+         << " coalesced=" << ls.coalesced << endl;
+}
+
+// ---------------------------------------------------------------------------
+// Pluggable eviction policies
+// ---------------------------------------------------------------------------
+// A policy only tracks which keys are resident and in what order; the cache
+// keeps the values. Every policy is O(1) per operation (lists + hash maps).
+template <typename K>
+class EvictionPolicy {
+public:
+    virtual ~EvictionPolicy() {}
+    virtual string name() const = 0;
+    
+    // A resident key was read or updated
+    virtual void recordHit(const K& key) = 0;
+    
+    // A non-resident key is inserted; resident keys pushed out by it (possibly
+    // none, possibly a rejected candidate) are appended to `evicted`
+    virtual void admit(const K& key, vector<K>& evicted) = 0;
+};
+
+// Recency list + index: the building block of every policy below
+template <typename K>
+class KeyList {
+private:
+    list<K> order;  // front = most recent
+    unordered_map<K, typename list<K>::iterator> pos;
+    
+public:
+    bool contains(const K& key) const { return pos.count(key) > 0; }
+    int size() const { return (int)pos.size(); }
+    bool empty() const { return pos.empty(); }
+    const K& back() const { return order.back(); }
+    
+    void pushFront(const K& key) {
+        order.push_front(key);
+        pos[key] = order.begin();
+    }
+    
+    void moveToFront(const K& key) {
+        order.splice(order.begin(), order, pos[key]);
+    }
+    
+    void erase(const K& key) {
+        auto it = pos.find(key);
+        order.erase(it->second);
+        pos.erase(it);
+    }
+    
+    K popBack() {
+        K key = order.back();
+        erase(key);
+        return key;
+    }
+};
+
+// Plain LRU, same behaviour as LRUCache's removeTail()
+template <typename K>
+class LRUPolicy : public EvictionPolicy<K> {
+private:
+    int capacity;
+    KeyList<K> lru;
+    
+public:
+    LRUPolicy(int cap) : capacity(max(cap, 1)) {}
+    string name() const override { return "LRU"; }
+    
+    void recordHit(const K& key) override { lru.moveToFront(key); }
+    
+    void admit(const K& key, vector<K>& evicted) override {
+        lru.pushFront(key);
+        if (lru.size() > capacity) evicted.push_back(lru.popBack());
+    }
+};
+
+// 2Q (Johnson & Shasha): first-time keys go to a small FIFO (A1in); only
+// keys seen again after leaving it (remembered in the ghost FIFO A1out)
+// reach the main LRU (Am). A one-pass scan therefore never touches Am.
+template <typename K>
+class TwoQPolicy : public EvictionPolicy<K> {
+private:
+    int capacity, kin, kout;
+    KeyList<K> a1in, a1out, am;
+    
+    void reclaim(vector<K>& evicted) {
+        if (a1in.size() + am.size() < capacity) return;
+        if (a1in.size() > kin || am.empty()) {
+            K key = a1in.popBack();
+            evicted.push_back(key);
+            a1out.pushFront(key);
+            if (a1out.size() > kout) a1out.popBack();
+        } else {
+            evicted.push_back(am.popBack());
+        }
+    }
+    
+public:
+    TwoQPolicy(int cap)
+        : capacity(max(cap, 1)), kin(max(1, capacity / 4)), kout(max(1, capacity / 2)) {}
+    string name() const override { return "2Q"; }
+    
+    void recordHit(const K& key) override {
+        if (am.contains(key)) am.moveToFront(key);  // A1in hits keep FIFO order
+    }
+    
+    void admit(const K& key, vector<K>& evicted) override {
+        reclaim(evicted);
+        if (a1out.contains(key)) {
+            a1out.erase(key);
+            am.pushFront(key);
+        } else {
+            a1in.pushFront(key);
+        }
+    }
+};
+
+// ARC (Megiddo & Modha): T1 holds keys seen once, T2 keys seen at least
+// twice; ghost lists B1/B2 remember recent evictions from each and steer
+// the target size p of T1 towards whichever side would have hit.
+template <typename K>
+class ARCPolicy : public EvictionPolicy<K> {
+private:
+    int capacity;
+    double p;  // target size of T1
+    KeyList<K> t1, t2, b1, b2;
+    
+    void replace(bool inB2, vector<K>& evicted) {
+        if (!t1.empty() && (t1.size() > p || (inB2 && t1.size() == (int)p) || t2.empty())) {
+            K key = t1.popBack();
+            evicted.push_back(key);
+            b1.pushFront(key);
+        } else {
+            K key = t2.popBack();
+            evicted.push_back(key);
+            b2.pushFront(key);
+        }
+    }
+    
+public:
+    ARCPolicy(int cap) : capacity(max(cap, 1)), p(0) {}
+    string name() const override { return "ARC"; }
+    
+    void recordHit(const K& key) override {
+        if (t1.contains(key)) t1.erase(key);
+        else t2.erase(key);
+        t2.pushFront(key);
+    }
+    
+    void admit(const K& key, vector<K>& evicted) override {
+        if (b1.contains(key)) {
+            p = min((double)capacity, p + max(1.0, (double)b2.size() / b1.size()));
+            replace(false, evicted);
+            b1.erase(key);
+            t2.pushFront(key);
+            return;
+        }
+        if (b2.contains(key)) {
+            p = max(0.0, p - max(1.0, (double)b1.size() / b2.size()));
+            replace(true, evicted);
+            b2.erase(key);
+            t2.pushFront(key);
+            return;
+        }
+        int l1 = t1.size() + b1.size();
+        int total = l1 + t2.size() + b2.size();
+        if (l1 == capacity) {
+            if (t1.size() < capacity) { b1.popBack(); replace(false, evicted); }
+            else evicted.push_back(t1.popBack());
+        } else if (total >= capacity) {
+            if (total == 2 * capacity) b2.popBack();
+            replace(false, evicted);
+        }
+        t1.pushFront(key);
+    }
+};
+
+// Count-min sketch of 4-bit saturating counters with periodic halving, so
+// old popularity fades (TinyLFU "reset" aging)
+template <typename K>
+class FrequencySketch {
+private:
+    static const int DEPTH = 4;
+    vector<uint8_t> table;  // DEPTH rows of `width` counters
+    size_t width;
+    int additions, sampleSize;
+    
+    size_t slot(size_t h, int row) const {
+        h += 0x9E3779B97F4A7C15ULL * (row + 1);
+        h ^= h >> 31; h *= 0xBF58476D1CE4E5B9ULL; h ^= h >> 29;
+        return row * width + (h & (width - 1));
+    }
+    
+public:
+    FrequencySketch(int capacity) : width(16), additions(0), sampleSize(10 * max(capacity, 1)) {
+        while (width < (size_t)capacity * 2) width <<= 1;
+        table.assign(DEPTH * width, 0);
+    }
+    
+    void increment(const K& key) {
+        size_t h = hash<K>{}(key);
+        for (int r = 0; r < DEPTH; r++) {
+            uint8_t& c = table[slot(h, r)];
+            if (c < 15) c++;
+        }
+        if (++additions >= sampleSize) {
+            for (auto& c : table) c >>= 1;
+            additions /= 2;
+        }
+    }
+    
+    int frequency(const K& key) const {
+        size_t h = hash<K>{}(key);
+        int f = 15;
+        for (int r = 0; r < DEPTH; r++) f = min(f, (int)table[slot(h, r)]);
+        return f;
+    }
+};
+
+// W-TinyLFU (Einziger, Friedman & Manes; Caffeine): new keys enter a 1%
+// LRU window. A key leaving the window only enters the segmented-LRU main
+// area if the sketch says it is more popular than the main area's victim,
+// so scans of one-off keys cannot flush the frequently used set.
+template <typename K>
+class WTinyLFUPolicy : public EvictionPolicy<K> {
+private:
+    int windowCap, probationCap, protectedCap;
+    KeyList<K> window, probation, protectedList;
+    FrequencySketch<K> sketch;
+    
+public:
+    WTinyLFUPolicy(int cap) : sketch(cap) {
+        cap = max(cap, 1);
+        windowCap    = max(1, cap / 100);
+        int mainCap  = cap - windowCap;
+        protectedCap = mainCap * 8 / 10;
+        probationCap = mainCap - protectedCap;
+    }
+    string name() const override { return "W-TinyLFU"; }
+    
+    void recordHit(const K& key) override {
+        sketch.increment(key);
+        if (window.contains(key)) {
+            window.moveToFront(key);
+        } else if (protectedList.contains(key)) {
+            protectedList.moveToFront(key);
+        } else {
+            // Second hit in main: promote, demoting protected's LRU if full
+            probation.erase(key);
+            protectedList.pushFront(key);
+            if (protectedList.size() > protectedCap) probation.pushFront(protectedList.popBack());
+        }
+    }
+    
+    void admit(const K& key, vector<K>& evicted) override {
+        sketch.increment(key);
+        window.pushFront(key);
+        if (window.size() <= windowCap) return;
+        
+        K candidate = window.popBack();
+        if (probation.size() + protectedList.size() < probationCap + protectedCap) {
+            probation.pushFront(candidate);
+            return;
+        }
+        KeyList<K>& victimList = probation.empty() ? protectedList : probation;
+        if (victimList.empty()) { evicted.push_back(candidate); return; }
+        if (sketch.frequency(candidate) > sketch.frequency(victimList.back())) {
+            evicted.push_back(victimList.popBack());
+            probation.pushFront(candidate);
+        } else {
+            evicted.push_back(candidate);
+        }
+    }
+};
+
+// Cache with a pluggable eviction policy (values in a hash map)
+template <typename K, typename V>
+class PolicyCache {
+private:
+    unique_ptr<EvictionPolicy<K>> policy;
+    unordered_map<K, V> values;
+    vector<K> evicted;  // scratch buffer reused by put()
+    
+public:
+    PolicyCache(unique_ptr<EvictionPolicy<K>> p) : policy(move(p)) {}
+    
+    bool tryGet(const K& key, V& out) {
+        auto it = values.find(key);
+        if (it == values.end()) return false;
+        policy->recordHit(key);
+        out = it->second;
+        return true;
+    }
+    
+    void put(const K& key, const V& value) {
+        auto it = values.find(key);
+        if (it != values.end()) {
+            it->second = value;
+            policy->recordHit(key);
+            return;
+        }
+        evicted.clear();
+        policy->admit(key, evicted);
+        values[key] = value;
+        for (const K& k : evicted) values.erase(k);
+    }
+    
+    bool contains(const K& key) const { return values.count(key) > 0; }
+    int getSize() const { return (int)values.size(); }
+    string policyName() const { return policy->name(); }
+};
+
+// Build each policy by name for the trace replay tool
+template <typename K>
+unique_ptr<EvictionPolicy<K>> makePolicy(const string& name, int capacity) {
+    if (name == "LRU") return make_unique<LRUPolicy<K>>(capacity);
+    if (name == "2Q")  return make_unique<TwoQPolicy<K>>(capacity);
+    if (name == "ARC") return make_unique<ARCPolicy<K>>(capacity);
+    if (name == "W-TinyLFU") return make_unique<WTinyLFUPolicy<K>>(capacity);
+    throw invalid_argument("Unknown policy: " + name);
+}
+
+// Replay a trace (cache-aside: get, put on miss) through LRUCache and
+// every policy; prints hit ratio and throughput
+void replayTrace(const vector<int>& trace, int capacity) {
+    cout << left << setw(18) << "policy" << right << setw(10) << "hit %" << setw(14) << "Mops/s" << endl;
+    auto report = [&](const string& name, function<bool(int)> access) {
+        long long hits = 0;
+        auto start = chrono::steady_clock::now();
+        for (int key : trace) hits += access(key);
+        double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << left << setw(18) << name << right << fixed << setprecision(2)
+             << setw(10) << 100.0 * hits / max<size_t>(trace.size(), 1)
+             << setw(14) << trace.size() / sec / 1e6 << endl;
+    };
+    
+    LRUCache<int, int> lru(capacity, false);
+    report("LRUCache", [&](int key) {
+        int v;
+        if (lru.tryGet(key, v)) return true;
+        lru.put(key, key);
+        return false;
+    });
+    for (string name : {"LRU", "2Q", "ARC", "W-TinyLFU"}) {
+        PolicyCache<int, int> cache(makePolicy<int>(name, capacity));
+        report(name, [&](int key) {
+            int v;
+            if (cache.tryGet(key, v)) return true;
+            cache.put(key, key);
+            return false;
+        });
+    }
+}
+
+// Trace file: whitespace-separated keys (any tokens); keys are interned to
+// ints before replay so every policy sees the same integer trace
+void replayTraceFile(const string& path, int capacity) {
+    ifstream in(path);
+    if (!in) { cout << "Cannot open trace file: " << path << endl; return; }
+    unordered_map<string, int> ids;
+    vector<int> trace;
+    string token;
+    while (in >> token) {
+        auto it = ids.emplace(token, (int)ids.size()).first;
+        trace.push_back(it->second);
+    }
+    cout << "Trace " << path << ": " << trace.size() << " accesses, " << ids.size()
+         << " distinct keys, capacity " << capacity << endl;
+    replayTrace(trace, capacity);
+}
+
 // Demo program
-int main() {
+// Usage: LRU_Cache_Simulation [trace_file [capacity]] replays a key trace
+// through every eviction policy instead of running the demo.
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        replayTraceFile(argv[1], argc > 2 ? stoi(argv[2]) : 1000);
+        return 0;
+    }
+    
     cout << "=== LRU Cache Simulation ===" << endl;
     cout << "Creating cache with capacity 3\n" << endl;
     
@@ -177,5 +1479,96 @@ int main() {
     strCache.put(3, "Charlie");  // Evicts Bob
     strCache.display();
     
+    // Sharded, thread-safe cache demo
+    cout << "\n=== Sharded LRU Cache (4 threads) ===" << endl;
+    ShardedLRUCache<int, string> shared(64, 8);
+    vector<thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.emplace_back([&shared, t]() {
+            for (int i = 0; i < 100; i++) shared.put(t * 100 + i, "v" + to_string(t * 100 + i));
+        });
+    }
+    for (auto& w : workers) w.join();
+    cout << "Shards: " << shared.getShardCount() << ", size: " << shared.getSize()
+         << "/" << shared.getCapacity() << endl;
+    cout << "get(399) = " << shared.get(399) << ", contains(0) = "
+         << (shared.contains(0) ? "yes" : "no") << endl;
+    
+    benchmarkShardedLRU(100000, 10000, 200000);
+    
+    // Scan resistance: Zipfian hot set interrupted by one-pass scans
+    cout << "\n=== Eviction policies: Zipfian traffic + periodic scans ===" << endl;
+    ZipfGenerator zipf(50000, 0.9, 7);
+    vector<int> trace;
+    int scanKey = 1000000;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 50000; i++) trace.push_back(zipf.next());
+        for (int i = 0; i < 5000; i++) trace.push_back(scanKey++);  // never reused
+    }
+    cout << trace.size() << " accesses, capacity 2000" << endl;
+    replayTrace(trace, 2000);
+    
+    // Production cache: preallocated nodes, counters instead of logging
+    cout << "\n=== Intrusive LRU Cache (capacity 3) ===" << endl;
+    IntrusiveLRUCache<string, int> fast(3);
+    fast.put("user:101", 42);
+    fast.put("user:202", 88);
+    fast.put("user:303", 15);
+    fast.get("user:101");
+    fast.put("user:404", 99);  // evicts user:202
+    fast.get("user:202");
+    cout << "MRU -> LRU:";
+    for (const auto& k : fast.keysByRecency()) cout << " " << k;
+    CacheStats fs = fast.stats();
+    cout << "\nhits=" << fs.hits << " misses=" << fs.misses << " evictions=" << fs.evictions << endl;
+    
+    benchmarkIntrusiveLRU(100000, 10000, 2000000);
+    
+    // Response cache: capacity in bytes, entries expire after their TTL
+    cout << "\n=== Expiring, Size-Aware LRU Cache (256 bytes, TTL 1000 ms) ===" << endl;
+    uint64_t fakeNow = 0;
+    ExpiringLRUCache<string, string> responses(
+        256, [](const string& k, const string& v) { return k.size() + v.size(); },
+        1000, [&] { return fakeNow; });
+    responses.put("/users/1", string(40, 'a'));
+    responses.put("/users/2", string(40, 'b'), 300);
+    responses.put("/catalog", string(120, 'c'), 5000);
+    responses.display();
+    responses.put("/report", string(32, 'd'));   // pushes out /users/1 by weight
+    responses.display();
+    cout << "Large value accepted? " << (responses.put("/dump", string(300, 'e')) ? "yes" : "no") << endl;
+    fakeNow = 500;
+    cout << "t=500ms, expired: " << responses.cleanUp() << endl;
+    responses.display();
+    fakeNow = 1200;
+    cout << "t=1200ms, expired: " << responses.cleanUp() << endl;
+    responses.display();
+    CacheStats rs = responses.stats();
+    cout << "evictions=" << rs.evictions << " expirations=" << rs.expirations << endl;
+    
+    benchmarkExpiringLRU(2000000);
+    
+    // Read-through: one backend call per key, refreshed before it expires
+    cout << "\n=== Read-Through Cache (TTL 300 ms, refresh after 100 ms) ===" << endl;
+    {
+        SlowBackend backend(50);
+        LoadingLRUCache<int, string> rt(100, 300, 100);
+        auto loader = [&](const int& key) { return backend.fetch(key); };
+        vector<thread> callers;
+        vector<string> seen(6);
+        for (int t = 0; t < 6; t++)
+            callers.emplace_back([&, t] { seen[t] = rt.getOrLoad(7, loader); });
+        for (auto& th : callers) th.join();
+        cout << "6 concurrent misses on key 7 -> " << seen[0]
+             << ", backend calls: " << backend.calls.load() << endl;
+        this_thread::sleep_for(chrono::milliseconds(150));
+        cout << "t~150ms hit (stale-while-refresh): " << rt.getOrLoad(7, loader) << endl;
+        this_thread::sleep_for(chrono::milliseconds(100));
+        cout << "t~250ms hit after refresh:         " << rt.getOrLoad(7, loader)
+             << ", backend calls: " << backend.calls.load() << endl;
+    }
+    
+    benchmarkSingleFlight(16, 100, 20, 20);
+    
     return 0;
 }
\ No newline at end of file
@@ -3,6 +3,25 @@
 #include <string>
 #include <algorithm>
 #include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <queue>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <functional>
+#include <stdexcept>
+#include <fstream>
+#include <filesystem>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
 // -- Trie Node --------------------------------------------------------------
@@ -11,8 +30,9 @@ struct TrieNode {
     bool      isEnd;
     int       freq;     // how many times this word was inserted
     int       prefixCount; // how many words pass through this node
+    int       maxFreq;  // highest freq of any word in this subtree
 
-    TrieNode() : isEnd(false), freq(0), prefixCount(0) {
+    TrieNode() : isEnd(false), freq(0), prefixCount(0), maxFreq(0) {
         fill(children, children + 26, nullptr);
     }
 };
@@ -54,6 +74,66 @@ private:
         return false;
     }
 
+    // Helper: (word, freq) pairs in sorted order, sharing one buffer
+    void collectEntries(TrieNode* node, string& current, vector<pair<string, int>>& out) const {
+        if (node->isEnd) out.push_back({current, node->freq});
+        for (int i = 0; i < 26; i++) {
+            if (!node->children[i]) continue;
+            current.push_back((char)('a' + i));
+            collectEntries(node->children[i], current, out);
+            current.pop_back();
+        }
+    }
+
+    size_t countNodes(TrieNode* node) const {
+        size_t n = 1;
+        for (int i = 0; i < 26; i++)
+            if (node->children[i]) n += countNodes(node->children[i]);
+        return n;
+    }
+
+    // Recompute maxFreq bottom-up along word's path (after freq drops)
+    void refreshMaxFreq(const string& word) {
+        vector<TrieNode*> path = {root};
+        for (char c : word) {
+            TrieNode* next = path.back()->children[idx(c)];
+            if (!next) break;
+            path.push_back(next);
+        }
+        for (int d = (int)path.size() - 1; d >= 0; d--) {
+            TrieNode* node = path[d];
+            node->maxFreq = node->isEnd ? node->freq : 0;
+            for (int i = 0; i < 26; i++)
+                if (node->children[i]) node->maxFreq = max(node->maxFreq, node->children[i]->maxFreq);
+        }
+    }
+
+    // Helper: one Levenshtein DP row per depth; rows[d] is the distance
+    // from the trie path of length d to every prefix of the query
+    void fuzzyHelper(TrieNode* node, const string& word, int maxDist, string& current,
+                     vector<vector<int>>& rows, vector<pair<string, int>>& results) const {
+        int depth = (int)current.size();
+        const vector<int>& prev = rows[depth - 1];
+        vector<int>& row = rows[depth];
+        int n = (int)word.size();
+        char c = current.back();
+        row[0] = prev[0] + 1;
+        int best = row[0];
+        for (int j = 1; j <= n; j++) {
+            int replace = prev[j - 1] + (word[j - 1] != c);
+            row[j] = min(replace, min(prev[j], row[j - 1]) + 1);
+            best = min(best, row[j]);
+        }
+        if (node->isEnd && row[n] <= maxDist) results.push_back({current, row[n]});
+        if (best > maxDist) return;   // every extension only gets further away
+        for (int i = 0; i < 26; i++) {
+            if (!node->children[i]) continue;
+            current.push_back((char)('a' + i));
+            fuzzyHelper(node->children[i], word, maxDist, current, rows, results);
+            current.pop_back();
+        }
+    }
+
     void destroyHelper(TrieNode* node) {
         if (!node) return;
         for (int i = 0; i < 26; i++) destroyHelper(node->children[i]);
@@ -93,6 +173,15 @@ public:
         if (!curr->isEnd) totalWords++;
         curr->isEnd = true;
         curr->freq++;
+
+        // Frequencies only grow here, so raising maxFreq on the path suffices
+        int f = curr->freq;
+        curr = root;
+        curr->maxFreq = max(curr->maxFreq, f);
+        for (char c : word) {
+            curr = curr->children[idx(c)];
+            curr->maxFreq = max(curr->maxFreq, f);
+        }
     }
 
     // Search for exact word
@@ -153,6 +242,79 @@ public:
         return results;
     }
 
+    // The k most frequent words with given prefix (ties alphabetical).
+    // Best-first search ordered by each subtree's maxFreq: every node it
+    // expands lies on the path to a result, so it touches at most
+    // k * (longest word) nodes no matter how large the subtree is.
+    vector<pair<string, int>> autocompleteTopK(const string& prefix, int k) const {
+        vector<pair<string, int>> results;
+        TrieNode* curr = root;
+        for (char c : prefix) {
+            int i = idx(c);
+            if (!curr->children[i]) return results;
+            curr = curr->children[i];
+        }
+
+        struct Item {
+            int       bound;  // freq for a word, maxFreq for a subtree
+            bool      word;
+            TrieNode* node;
+            string    path;
+        };
+        // Highest bound first; equal bounds in path order, a word before its extensions
+        auto worse = [](const Item& a, const Item& b) {
+            if (a.bound != b.bound) return a.bound < b.bound;
+            int c = a.path.compare(b.path);
+            if (c != 0) return c > 0;
+            return !a.word && b.word;
+        };
+        priority_queue<Item, vector<Item>, decltype(worse)> frontier(worse);
+        if (curr->maxFreq > 0) frontier.push({curr->maxFreq, false, curr, prefix});
+
+        while (!frontier.empty() && (int)results.size() < k) {
+            Item top = frontier.top();
+            frontier.pop();
+            if (top.word) {
+                results.push_back({top.path, top.bound});
+                continue;
+            }
+            TrieNode* node = top.node;
+            if (node->isEnd) frontier.push({node->freq, true, nullptr, top.path});
+            for (int i = 0; i < 26; i++) {
+                TrieNode* ch = node->children[i];
+                if (ch && ch->maxFreq > 0)
+                    frontier.push({ch->maxFreq, false, ch, top.path + (char)('a' + i)});
+            }
+        }
+        return results;
+    }
+
+    // Words within maxDist edits of word, closest first (ties alphabetical).
+    // Walks the trie once, extending one DP row per level, and abandons a
+    // branch as soon as its row minimum exceeds maxDist.
+    vector<pair<string, int>> fuzzySearch(const string& word, int maxDist) const {
+        vector<pair<string, int>> results;
+        if (maxDist < 0) return results;
+        string query;
+        for (char c : word) query += (char)tolower(c);
+        int n = (int)query.size();
+        // A row minimum is at least depth - n, so no live path is deeper than n + maxDist + 1
+        vector<vector<int>> rows(n + maxDist + 2, vector<int>(n + 1));
+        for (int j = 0; j <= n; j++) rows[0][j] = j;
+        if (root->isEnd && n <= maxDist) results.push_back({"", n});
+        string current;
+        for (int i = 0; i < 26; i++) {
+            if (!root->children[i]) continue;
+            current.push_back((char)('a' + i));
+            fuzzyHelper(root->children[i], query, maxDist, current, rows, results);
+            current.pop_back();
+        }
+        sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second < b.second : a.first < b.first;
+        });
+        return results;
+    }
+
     // Delete a word
     bool remove(const string& word) {
         if (!search(word)) return false;
@@ -163,6 +325,7 @@ public:
             curr->prefixCount--;
         }
         bool removed = deleteHelper(root, word, 0);
+        refreshMaxFreq(word);
         if (removed || search(word) == false) {
             totalWords--;
             return true;
@@ -188,6 +351,17 @@ public:
 
     int size() const { return totalWords; }
 
+    // All words with their frequencies, sorted
+    vector<pair<string, int>> entries() const {
+        vector<pair<string, int>> out;
+        string current;
+        collectEntries(root, current, out);
+        return out;
+    }
+
+    size_t nodeCount() const { return countNodes(root); }
+    size_t memoryBytes() const { return nodeCount() * sizeof(TrieNode); }
+
     void printStructure() const {
         cout << "(root)\n";
         printHelper(root, "(root)", "");
@@ -196,6 +370,1281 @@ public:
     ~Trie() { destroyHelper(root); }
 };
 
+// -- Compact Radix Trie -----------------------------------------------------
+// Read-only, path-compressed trie in flat arrays. Each node keeps its edge
+// label as a slice of one shared character pool, and the children of a node
+// are stored next to each other in label order, so a node costs 20 bytes
+// instead of 26 pointers. Nodes refer to each other by index only, which is
+// what lets the same arrays be written to disk and mapped back (TrieImage).
+struct RadixNode {
+    uint32_t labelStart;   // edge label = pool[labelStart, labelStart + labelLen)
+    uint32_t firstChild;   // children = nodes[firstChild, firstChild + childCount)
+    uint32_t freq;         // > 0 only where a word ends
+    uint32_t prefixCount;  // insertions of words in this subtree
+    uint16_t labelLen;
+    uint16_t childCount;
+};
+
+// Queries over radix arrays wherever they live (vectors or a mapped file).
+// Labels are stored lower-case; query keys are folded a character at a time,
+// as Trie does, so lookups are case-insensitive without copying the key.
+class RadixTrieView {
+private:
+    const RadixNode* nodes;   // nodes[0] is the root, with an empty label
+    const char*      pool;
+
+    static char fold(char c) { return (char)tolower((unsigned char)c); }
+
+    // Child of n whose label starts with c, or -1
+    int child(const RadixNode& n, char c) const {
+        for (uint32_t i = n.firstChild; i < n.firstChild + n.childCount; i++) {
+            unsigned char f = pool[nodes[i].labelStart];
+            if (f == (unsigned char)c) return (int)i;
+            if (f > (unsigned char)c) break;
+        }
+        return -1;
+    }
+
+    // Follow key from the root. Returns the node whose edge holds the last
+    // character (-1 if key is not a prefix of any word); matched is how much
+    // of that node's label the key covered.
+    int walk(const string& key, size_t& matched) const {
+        int cur = 0;
+        size_t i = 0;
+        matched = 0;
+        while (i < key.size()) {
+            int c = child(nodes[cur], fold(key[i]));
+            if (c < 0) return -1;
+            const RadixNode& n = nodes[c];
+            size_t len = min<size_t>(n.labelLen, key.size() - i);
+            for (size_t k = 0; k < len; k++)
+                if (pool[n.labelStart + k] != fold(key[i + k])) return -1;
+            i += len;
+            cur = c;
+            matched = len;
+        }
+        return cur;
+    }
+
+    void collect(int node, string& current, vector<string>& results) const {
+        const RadixNode& n = nodes[node];
+        if (n.freq) results.push_back(current);
+        for (uint32_t i = n.firstChild; i < n.firstChild + n.childCount; i++) {
+            size_t mark = current.size();
+            current.append(pool + nodes[i].labelStart, nodes[i].labelLen);
+            collect((int)i, current, results);
+            current.resize(mark);
+        }
+    }
+
+public:
+    RadixTrieView(const RadixNode* nodes, const char* pool) : nodes(nodes), pool(pool) {}
+
+    bool search(const string& word) const { return frequency(word) > 0; }
+
+    bool startsWith(const string& prefix) const {
+        size_t matched;
+        return walk(prefix, matched) >= 0;
+    }
+
+    int countWithPrefix(const string& prefix) const {
+        size_t matched;
+        int n = walk(prefix, matched);
+        return n < 0 ? 0 : (int)nodes[n].prefixCount;
+    }
+
+    int frequency(const string& word) const {
+        size_t matched;
+        int n = walk(word, matched);
+        if (n < 0 || matched != nodes[n].labelLen) return 0;
+        return (int)nodes[n].freq;
+    }
+
+    // Sorted without a final sort: children are kept in label order
+    vector<string> autocomplete(const string& prefix) const {
+        vector<string> results;
+        size_t matched;
+        int n = walk(prefix, matched);
+        if (n < 0) return results;
+        string current = prefix;
+        current.append(pool + nodes[n].labelStart + matched, nodes[n].labelLen - matched);
+        collect(n, current, results);
+        return results;
+    }
+};
+
+// Built once from (word, freq) pairs, e.g. Trie::entries() or a word list.
+// Words are lower-cased on the way in, like Trie::insert, so mixed-case
+// spellings of a word merge into one entry.
+class CompactTrie {
+private:
+    vector<RadixNode> nodes;
+    string            pool;
+    int               totalWords;
+
+    RadixTrieView view() const { return RadixTrieView(nodes.data(), pool.data()); }
+
+public:
+    explicit CompactTrie(vector<pair<string, int>> words) : totalWords(0) {
+        // Fold case, sort and merge duplicates; each node then covers a contiguous range
+        for (auto& w : words)
+            for (char& c : w.first) c = (char)tolower((unsigned char)c);
+        sort(words.begin(), words.end());
+        size_t out = 0;
+        for (size_t i = 0; i < words.size(); i++) {
+            if (out && words[out - 1].first == words[i].first) words[out - 1].second += words[i].second;
+            else words[out++] = words[i];
+        }
+        words.resize(out);
+
+        // No words: just a label-less, childless root
+        nodes.push_back(RadixNode{0, 0, 0, 0, 0, 0});
+        if (words.empty()) return;
+
+        // Breadth-first so each node's children are allocated together
+        struct Pending { uint32_t node; size_t lo, hi, depth; };
+        vector<Pending> queue = {{0, 0, words.size(), 0}};
+        for (size_t q = 0; q < queue.size(); q++) {
+            Pending p = queue[q];
+            size_t end = p.depth;
+            if (p.node != 0) {
+                // Sorted range: the common prefix of all is that of first and last
+                const string& a = words[p.lo].first;
+                const string& b = words[p.hi - 1].first;
+                while (end < a.size() && end < b.size() && a[end] == b[end] &&
+                       end - p.depth < 0xFFFF) end++;
+            }
+            uint32_t count = 0;
+            for (size_t i = p.lo; i < p.hi; i++) count += words[i].second;
+
+            RadixNode& n = nodes[p.node];
+            n.labelStart = (uint32_t)pool.size();
+            n.labelLen = (uint16_t)(end - p.depth);
+            n.prefixCount = count;
+            pool.append(words[p.lo].first, p.depth, end - p.depth);
+
+            size_t lo = p.lo;
+            if (words[lo].first.size() == end) {
+                n.freq = words[lo].second;
+                totalWords++;
+                lo++;
+            }
+            n.firstChild = (uint32_t)nodes.size();
+            uint16_t children = 0;
+            for (size_t i = lo; i < p.hi;) {
+                char c = words[i].first[end];
+                size_t j = i;
+                while (j < p.hi && words[j].first[end] == c) j++;
+                queue.push_back({(uint32_t)nodes.size(), i, j, end});
+                nodes.push_back(RadixNode{0, 0, 0, 0, 0, 0});
+                children++;
+                i = j;
+            }
+            nodes[p.node].childCount = children;
+        }
+        nodes.shrink_to_fit();
+        pool.shrink_to_fit();
+    }
+
+    // Search for exact word
+    bool search(const string& word) const { return view().search(word); }
+
+    // Check if any word starts with prefix
+    bool startsWith(const string& prefix) const { return view().startsWith(prefix); }
+
+    // Count words with given prefix
+    int countWithPrefix(const string& prefix) const { return view().countWithPrefix(prefix); }
+
+    // Get word frequency
+    int frequency(const string& word) const { return view().frequency(word); }
+
+    // Autocomplete: all words with given prefix, sorted
+    vector<string> autocomplete(const string& prefix) const { return view().autocomplete(prefix); }
+
+    // Write the arrays as a TrieImage file (see layout below)
+    void saveImage(const string& path) const;
+
+    int size() const { return totalWords; }
+    size_t nodeCount() const { return nodes.size(); }
+    size_t memoryBytes() const { return nodes.capacity() * sizeof(RadixNode) + pool.capacity(); }
+};
+
+// -- Memory-mapped Trie image -----------------------------------------------
+class MappedFile {
+private:
+    const char* data;
+    size_t      len;
+    string      buffer;   // fallback storage when mmap is unavailable
+
+public:
+    explicit MappedFile(const string& path) : data(nullptr), len(0) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("Cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) { close(fd); throw runtime_error("Cannot stat " + path); }
+        len = (size_t)st.st_size;
+        if (len > 0) {
+            void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) { close(fd); throw runtime_error("Cannot mmap " + path); }
+            data = static_cast<const char*>(p);
+        }
+        close(fd);
+#else
+        ifstream in(path, ios::binary);
+        if (!in) throw runtime_error("Cannot open " + path);
+        buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        data = buffer.data();
+        len  = buffer.size();
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (data) munmap(const_cast<char*>(data), len);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return data; }
+    size_t      size() const { return len; }
+};
+
+// File layout (native byte order):
+//   TrieImageHeader
+//   RadixNode nodes[nodeCount]   at nodesOffset, breadth-first, root first
+//   char      pool[poolBytes]    at poolOffset, all edge labels
+// Loading is one mmap plus one validation pass over the node array; queries
+// then read the nodes in place, and pool pages are only faulted in when a
+// lookup touches them.
+struct TrieImageHeader {
+    char     magic[8];      // "TRIEIMG"
+    uint32_t version;
+    uint32_t byteOrder;     // 0x01020304 in the writer's byte order
+    uint32_t nodeBytes;
+    uint32_t totalWords;
+    uint64_t nodeCount;
+    uint64_t nodesOffset;
+    uint64_t poolOffset;
+    uint64_t poolBytes;
+    uint64_t fileBytes;
+};
+
+void CompactTrie::saveImage(const string& path) const {
+    TrieImageHeader h{};
+    memcpy(h.magic, "TRIEIMG", 8);
+    h.version     = 1;
+    h.byteOrder   = 0x01020304;
+    h.nodeBytes   = sizeof(RadixNode);
+    h.totalWords  = (uint32_t)totalWords;
+    h.nodeCount   = nodes.size();
+    h.nodesOffset = sizeof(TrieImageHeader);
+    h.poolOffset  = h.nodesOffset + nodes.size() * sizeof(RadixNode);
+    h.poolBytes   = pool.size();
+    h.fileBytes   = h.poolOffset + pool.size();
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) throw runtime_error("Cannot write " + path);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(RadixNode));
+    out.write(pool.data(), pool.size());
+    if (!out) throw runtime_error("Write failed: " + path);
+}
+
+// Read-only trie answered straight from a mapped image file
+class TrieImage {
+private:
+    MappedFile             file;
+    const TrieImageHeader* header;
+
+    RadixTrieView view() const {
+        return RadixTrieView(reinterpret_cast<const RadixNode*>(file.begin() + header->nodesOffset),
+                             file.begin() + header->poolOffset);
+    }
+
+public:
+    explicit TrieImage(const string& path) : file(path) {
+        if (file.size() < sizeof(TrieImageHeader)) throw runtime_error("Not a trie image: " + path);
+        header = reinterpret_cast<const TrieImageHeader*>(file.begin());
+        if (memcmp(header->magic, "TRIEIMG", 8) != 0 || header->version != 1)
+            throw runtime_error("Not a trie image: " + path);
+        if (header->byteOrder != 0x01020304 || header->nodeBytes != sizeof(RadixNode))
+            throw runtime_error("Trie image built for another platform: " + path);
+        const uint64_t maxNodes = min<uint64_t>(UINT32_MAX, file.size() / sizeof(RadixNode));
+        if (header->fileBytes != file.size() || header->nodeCount == 0 || header->nodeCount > maxNodes ||
+            header->nodesOffset < sizeof(TrieImageHeader) || header->nodesOffset > file.size() ||
+            header->poolOffset != header->nodesOffset + header->nodeCount * sizeof(RadixNode) ||
+            header->poolOffset > file.size() || header->poolBytes != file.size() - header->poolOffset)
+            throw runtime_error("Truncated or corrupt trie image: " + path);
+        if (header->nodesOffset % alignof(RadixNode) != 0)   // the mapping itself is page aligned
+            throw runtime_error("Misaligned trie image: " + path);
+
+        // One pass over the nodes so queries can trust them: labels inside the
+        // pool, children inside the node array, and every child stored after
+        // its parent (as the breadth-first writer does), which rules out cycles.
+        // Only the root may have an empty label; child() reads a label's first byte.
+        const RadixNode* nodes = reinterpret_cast<const RadixNode*>(file.begin() + header->nodesOffset);
+        for (uint64_t i = 0; i < header->nodeCount; i++) {
+            const RadixNode& n = nodes[i];
+            bool labelOk = (uint64_t)n.labelStart + n.labelLen <= header->poolBytes && (i == 0 || n.labelLen > 0);
+            bool childrenOk = n.childCount == 0 ||
+                              (n.firstChild > i && (uint64_t)n.firstChild + n.childCount <= header->nodeCount);
+            if (!labelOk || !childrenOk)
+                throw runtime_error("Corrupt trie image node " + to_string(i) + ": " + path);
+        }
+    }
+
+    bool search(const string& word) const { return view().search(word); }
+    bool startsWith(const string& prefix) const { return view().startsWith(prefix); }
+    int countWithPrefix(const string& prefix) const { return view().countWithPrefix(prefix); }
+    int frequency(const string& word) const { return view().frequency(word); }
+    vector<string> autocomplete(const string& prefix) const { return view().autocomplete(prefix); }
+
+    int size() const { return (int)header->totalWords; }
+    size_t fileBytes() const { return file.size(); }
+};
+
+// -- Byte Trie --------------------------------------------------------------
+// Alphabet-agnostic trie over raw bytes (so UTF-8, digits and punctuation
+// all work). Children are kept in byte order in one array; which byte maps
+// to which slot is stored either as a small sorted key list (sparse nodes)
+// or, past kSparseMax children, as a 256-bit bitmap where a child's slot is
+// the popcount of the bits below it (dense nodes).
+struct ByteTrieNode {
+    static const int kSparseMax = 16;
+
+    ByteTrieNode** kids;     // children in byte order
+    uint16_t       count, cap;
+    bool           dense;
+    bool           isEnd;
+    int            freq;
+    int            prefixCount;
+    union {
+        uint8_t  keys[kSparseMax];   // sparse: sorted child bytes
+        uint64_t bits[4];            // dense: bit b set if byte b has a child
+    };
+
+    ByteTrieNode() : kids(nullptr), count(0), cap(0), dense(false),
+                     isEnd(false), freq(0), prefixCount(0) {
+        fill(bits, bits + 4, 0);
+    }
+    ~ByteTrieNode() { delete[] kids; }
+
+    // Slot of byte b, or where it would be inserted (found tells which)
+    int slotOf(uint8_t b, bool& found) const {
+        if (dense) {
+            found = (bits[b >> 6] >> (b & 63)) & 1;
+            int slot = 0;
+            for (int w = 0; w < (b >> 6); w++) slot += __builtin_popcountll(bits[w]);
+            uint64_t below = (b & 63) ? bits[b >> 6] & ((1ULL << (b & 63)) - 1) : 0;
+            return slot + __builtin_popcountll(below);
+        }
+        int i = 0;
+        while (i < count && keys[i] < b) i++;
+        found = i < count && keys[i] == b;
+        return i;
+    }
+
+    ByteTrieNode* child(uint8_t b) const {
+        bool found;
+        int slot = slotOf(b, found);
+        return found ? kids[slot] : nullptr;
+    }
+
+    uint8_t keyAt(int slot) const {
+        if (!dense) return keys[slot];
+        for (int w = 0; w < 4; w++) {
+            int c = __builtin_popcountll(bits[w]);
+            if (slot < c) {
+                uint64_t x = bits[w];
+                while (slot--) x &= x - 1;
+                return (uint8_t)(w * 64 + __builtin_ctzll(x));
+            }
+            slot -= c;
+        }
+        return 0;
+    }
+
+    void addChild(uint8_t b, ByteTrieNode* node) {
+        bool found;
+        int slot = slotOf(b, found);
+        if (!dense && count == kSparseMax) {
+            uint8_t old[kSparseMax];
+            copy(keys, keys + count, old);
+            fill(bits, bits + 4, 0);
+            for (int i = 0; i < count; i++) bits[old[i] >> 6] |= 1ULL << (old[i] & 63);
+            dense = true;
+        }
+        if (count == cap) {
+            cap = cap ? min(cap * 2, 256) : 2;
+            ByteTrieNode** grown = new ByteTrieNode*[cap];
+            copy(kids, kids + count, grown);
+            delete[] kids;
+            kids = grown;
+        }
+        copy_backward(kids + slot, kids + count, kids + count + 1);
+        kids[slot] = node;
+        if (dense) {
+            bits[b >> 6] |= 1ULL << (b & 63);
+        } else {
+            copy_backward(keys + slot, keys + count, keys + count + 1);
+            keys[slot] = b;
+        }
+        count++;
+    }
+
+    void removeChild(uint8_t b) {
+        bool found;
+        int slot = slotOf(b, found);
+        if (!found) return;
+        copy(kids + slot + 1, kids + count, kids + slot);
+        count--;
+        if (dense) {
+            bits[b >> 6] &= ~(1ULL << (b & 63));
+            if (count <= kSparseMax / 2) {   // back to sparse, with hysteresis
+                uint8_t ks[kSparseMax];
+                for (int i = 0; i < count; i++) ks[i] = keyAt(i);
+                dense = false;
+                copy(ks, ks + count, keys);
+            }
+        } else {
+            copy(keys + slot + 1, keys + count + 1, keys + slot);
+        }
+    }
+};
+
+class ByteTrie {
+private:
+    ByteTrieNode* root;
+    int           totalWords;
+
+    const ByteTrieNode* find(const string& key) const {
+        const ByteTrieNode* curr = root;
+        for (char c : key) {
+            curr = curr->child((uint8_t)c);
+            if (!curr) return nullptr;
+        }
+        return curr;
+    }
+
+    void collectWords(const ByteTrieNode* node, string& current, vector<string>& results) const {
+        if (node->isEnd) results.push_back(current);
+        for (int i = 0; i < node->count; i++) {
+            current.push_back((char)node->keyAt(i));
+            collectWords(node->kids[i], current, results);
+            current.pop_back();
+        }
+    }
+
+    size_t bytesHelper(const ByteTrieNode* node, size_t& nodes) const {
+        nodes++;
+        size_t bytes = sizeof(ByteTrieNode) + node->cap * sizeof(ByteTrieNode*);
+        for (int i = 0; i < node->count; i++) bytes += bytesHelper(node->kids[i], nodes);
+        return bytes;
+    }
+
+    void destroyHelper(ByteTrieNode* node) {
+        for (int i = 0; i < node->count; i++) destroyHelper(node->kids[i]);
+        delete node;
+    }
+
+public:
+    ByteTrie() : root(new ByteTrieNode()), totalWords(0) {}
+    ~ByteTrie() { destroyHelper(root); }
+    ByteTrie(const ByteTrie&) = delete;
+    ByteTrie& operator=(const ByteTrie&) = delete;
+
+    // Insert a word (any bytes, taken as-is)
+    void insert(const string& word) {
+        ByteTrieNode* curr = root;
+        for (char c : word) {
+            ByteTrieNode* next = curr->child((uint8_t)c);
+            if (!next) {
+                next = new ByteTrieNode();
+                curr->addChild((uint8_t)c, next);
+            }
+            curr = next;
+            curr->prefixCount++;
+        }
+        if (!curr->isEnd) totalWords++;
+        curr->isEnd = true;
+        curr->freq++;
+    }
+
+    // Search for exact word
+    bool search(const string& word) const {
+        const ByteTrieNode* n = find(word);
+        return n && n->isEnd;
+    }
+
+    // Check if any word starts with prefix
+    bool startsWith(const string& prefix) const { return find(prefix) != nullptr; }
+
+    // Count words with given prefix
+    int countWithPrefix(const string& prefix) const {
+        const ByteTrieNode* n = find(prefix);
+        return n ? n->prefixCount : 0;
+    }
+
+    // Get word frequency
+    int frequency(const string& word) const {
+        const ByteTrieNode* n = find(word);
+        return n && n->isEnd ? n->freq : 0;
+    }
+
+    // Autocomplete: all words with given prefix, sorted by byte value
+    vector<string> autocomplete(const string& prefix) const {
+        vector<string> results;
+        const ByteTrieNode* n = find(prefix);
+        if (!n) return results;
+        string current = prefix;
+        collectWords(n, current, results);
+        return results;
+    }
+
+    // Delete a word, pruning nodes that no longer lead anywhere
+    bool remove(const string& word) {
+        vector<ByteTrieNode*> path = {root};
+        for (char c : word) {
+            ByteTrieNode* next = path.back()->child((uint8_t)c);
+            if (!next) return false;
+            path.push_back(next);
+        }
+        if (!path.back()->isEnd) return false;
+        for (size_t d = 1; d < path.size(); d++) path[d]->prefixCount--;
+        path.back()->isEnd = false;
+        path.back()->freq = 0;
+        for (size_t d = path.size() - 1; d > 0; d--) {
+            ByteTrieNode* node = path[d];
+            if (node->isEnd || node->count) break;
+            path[d - 1]->removeChild((uint8_t)word[d - 1]);
+            delete node;
+        }
+        totalWords--;
+        return true;
+    }
+
+    int size() const { return totalWords; }
+
+    size_t nodeCount() const {
+        size_t nodes = 0;
+        bytesHelper(root, nodes);
+        return nodes;
+    }
+
+    size_t memoryBytes() const {
+        size_t nodes = 0;
+        return bytesHelper(root, nodes);
+    }
+};
+
+// -- Epoch-based reclamation ------------------------------------------------
+// Readers pin the current global epoch while they hold raw node pointers.
+// Unlinked nodes are retired with the epoch at unlink time and freed once the
+// global epoch has moved two steps past it: every reader that could still
+// see them has unpinned by then.
+class EpochDomain {
+public:
+    static constexpr int kMaxThreads = 256;
+
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    uint64_t current() const { return global.load(); }
+
+    void pin() {
+        ThreadSlot& t = threadSlot();
+        if (t.depth++ == 0) {
+            t.slot->epoch.store(global.load());
+            atomic_thread_fence(memory_order_seq_cst);   // pin before any node load
+        }
+    }
+
+    void unpin() {
+        ThreadSlot& t = threadSlot();
+        if (--t.depth == 0) t.slot->epoch.store(0);
+    }
+
+    // Advance only when every pinned thread has seen the current epoch
+    void tryAdvance() {
+        uint64_t e = global.load();
+        for (const auto& s : slots) {
+            uint64_t se = s.epoch.load();
+            if (se != 0 && se != e) return;
+        }
+        global.compare_exchange_strong(e, e + 1);
+    }
+
+    bool safeToFree(uint64_t retiredAt) const { return retiredAt + 2 <= global.load(); }
+
+private:
+    struct alignas(64) Slot {
+        atomic<uint64_t> epoch{0};   // 0 = not inside a read section
+        atomic<bool>     taken{false};
+    };
+
+    struct ThreadSlot {
+        Slot* slot  = nullptr;
+        int   depth = 0;
+        ~ThreadSlot() { if (slot) slot->taken.store(false); }
+    };
+
+    atomic<uint64_t> global{1};
+    Slot             slots[kMaxThreads];
+
+    ThreadSlot& threadSlot() {
+        static thread_local ThreadSlot t;
+        if (!t.slot) {
+            for (auto& s : slots) {
+                bool expected = false;
+                if (s.taken.compare_exchange_strong(expected, true)) { t.slot = &s; break; }
+            }
+            if (!t.slot) throw runtime_error("EpochDomain: too many threads.");
+        }
+        return t;
+    }
+};
+
+struct EpochGuard {
+    EpochGuard()  { EpochDomain::instance().pin(); }
+    ~EpochGuard() { EpochDomain::instance().unpin(); }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// -- Concurrent Trie --------------------------------------------------------
+// Readers take no lock: they pin an epoch and follow child pointers with
+// acquire loads. Inserts create missing children with a CAS on the parent's
+// slot, so inserts of different words run in parallel; writers of the same
+// word are serialized by a striped lock so freq/isEnd/prefixCount agree.
+// Removal is logical (counts drop, isEnd clears); subtrees whose prefixCount
+// reaches zero are unlinked under a short exclusive writer lock and retired
+// through EpochDomain, so a reader still inside them stays safe.
+struct ConcurrentTrieNode {
+    atomic<ConcurrentTrieNode*> children[26];
+    atomic<bool> isEnd;
+    atomic<int>  freq;
+    atomic<int>  prefixCount;   // insertions of words present in this subtree
+
+    ConcurrentTrieNode() : isEnd(false), freq(0), prefixCount(0) {
+        for (auto& c : children) c.store(nullptr, memory_order_relaxed);
+    }
+};
+
+class ConcurrentTrie {
+private:
+    static const int kWordLocks = 64;
+
+    ConcurrentTrieNode* root;
+    atomic<int>         totalWords;
+    shared_mutex        structureLock;   // writers: shared to update, exclusive to unlink
+    mutex               wordLocks[kWordLocks];
+    vector<pair<uint64_t, ConcurrentTrieNode*>> retired;   // guarded by structureLock (exclusive)
+
+    int idx(char c) const { return tolower(c) - 'a'; }
+
+    // Stripe by the case-folded word: "Apple" and "apple" reach the same
+    // nodes through idx(), so they must serialize on the same lock
+    mutex& wordLock(const string& word) {
+        uint64_t h = 14695981039346656037ULL;   // FNV-1a
+        for (char c : word) { h ^= (unsigned char)tolower((unsigned char)c); h *= 1099511628211ULL; }
+        return wordLocks[h % kWordLocks];
+    }
+
+    const ConcurrentTrieNode* find(const string& key) const {
+        const ConcurrentTrieNode* curr = root;
+        for (char c : key) {
+            curr = curr->children[idx(c)].load(memory_order_acquire);
+            if (!curr) return nullptr;
+        }
+        return curr;
+    }
+
+    void collectWords(const ConcurrentTrieNode* node, string& current, vector<string>& results) const {
+        if (node->isEnd.load(memory_order_acquire)) results.push_back(current);
+        for (int i = 0; i < 26; i++) {
+            const ConcurrentTrieNode* ch = node->children[i].load(memory_order_acquire);
+            if (!ch) continue;
+            current.push_back((char)('a' + i));
+            collectWords(ch, current, results);
+            current.pop_back();
+        }
+    }
+
+    // Unlink the highest empty node on word's path; caller saw a count hit zero
+    void prune(const string& word) {
+        unique_lock<shared_mutex> lk(structureLock);
+        ConcurrentTrieNode* parent = root;
+        for (char c : word) {
+            int i = idx(c);
+            ConcurrentTrieNode* node = parent->children[i].load(memory_order_relaxed);
+            if (!node) return;
+            if (node->prefixCount.load(memory_order_relaxed) == 0) {
+                parent->children[i].store(nullptr, memory_order_release);
+                atomic_thread_fence(memory_order_seq_cst);   // unlink before reading the epoch
+                uint64_t epoch = EpochDomain::instance().current();
+                vector<ConcurrentTrieNode*> stack = {node};
+                while (!stack.empty()) {
+                    ConcurrentTrieNode* n = stack.back();
+                    stack.pop_back();
+                    for (auto& ch : n->children)
+                        if (ConcurrentTrieNode* x = ch.load(memory_order_relaxed)) stack.push_back(x);
+                    retired.push_back({epoch, n});
+                }
+                break;
+            }
+            parent = node;
+        }
+        EpochDomain::instance().tryAdvance();
+        size_t kept = 0;
+        for (auto& r : retired) {
+            if (EpochDomain::instance().safeToFree(r.first)) delete r.second;
+            else retired[kept++] = r;
+        }
+        retired.resize(kept);
+    }
+
+    void destroyHelper(ConcurrentTrieNode* node) {
+        for (auto& c : node->children)
+            if (ConcurrentTrieNode* ch = c.load(memory_order_relaxed)) destroyHelper(ch);
+        delete node;
+    }
+
+public:
+    ConcurrentTrie() : root(new ConcurrentTrieNode()), totalWords(0) {}
+
+    ~ConcurrentTrie() {
+        destroyHelper(root);
+        for (auto& r : retired) delete r.second;
+    }
+
+    ConcurrentTrie(const ConcurrentTrie&) = delete;
+    ConcurrentTrie& operator=(const ConcurrentTrie&) = delete;
+
+    // Insert a word
+    void insert(const string& word) {
+        shared_lock<shared_mutex> structure(structureLock);
+        lock_guard<mutex> lk(wordLock(word));
+        ConcurrentTrieNode* curr = root;
+        for (char c : word) {
+            atomic<ConcurrentTrieNode*>& slot = curr->children[idx(c)];
+            ConcurrentTrieNode* next = slot.load(memory_order_acquire);
+            if (!next) {
+                ConcurrentTrieNode* fresh = new ConcurrentTrieNode();
+                if (slot.compare_exchange_strong(next, fresh, memory_order_acq_rel)) next = fresh;
+                else delete fresh;   // another insert won; next now holds its node
+            }
+            next->prefixCount.fetch_add(1, memory_order_relaxed);
+            curr = next;
+        }
+        curr->freq.fetch_add(1, memory_order_relaxed);
+        if (!curr->isEnd.exchange(true, memory_order_release)) totalWords++;
+    }
+
+    // Delete a word (all its insertions)
+    bool remove(const string& word) {
+        bool emptied = false;
+        {
+            shared_lock<shared_mutex> structure(structureLock);
+            lock_guard<mutex> lk(wordLock(word));
+            vector<ConcurrentTrieNode*> path;
+            ConcurrentTrieNode* curr = root;
+            for (char c : word) {
+                curr = curr->children[idx(c)].load(memory_order_acquire);
+                if (!curr) return false;
+                path.push_back(curr);
+            }
+            if (!curr->isEnd.load(memory_order_relaxed)) return false;
+            curr->isEnd.store(false, memory_order_release);
+            int removed = curr->freq.exchange(0, memory_order_relaxed);
+            for (ConcurrentTrieNode* n : path)
+                if (n->prefixCount.fetch_sub(removed, memory_order_relaxed) == removed) emptied = true;
+            totalWords--;
+        }
+        if (emptied) prune(word);
+        return true;
+    }
+
+    // Search for exact word (never blocks)
+    bool search(const string& word) const {
+        EpochGuard g;
+        const ConcurrentTrieNode* n = find(word);
+        return n && n->isEnd.load(memory_order_acquire);
+    }
+
+    // Check if any word starts with prefix
+    bool startsWith(const string& prefix) const {
+        EpochGuard g;
+        const ConcurrentTrieNode* n = find(prefix);
+        return n && n->prefixCount.load(memory_order_relaxed) > 0;
+    }
+
+    // Count words with given prefix
+    int countWithPrefix(const string& prefix) const {
+        EpochGuard g;
+        const ConcurrentTrieNode* n = find(prefix);
+        return n ? n->prefixCount.load(memory_order_relaxed) : 0;
+    }
+
+    // Get word frequency
+    int frequency(const string& word) const {
+        EpochGuard g;
+        const ConcurrentTrieNode* n = find(word);
+        return n && n->isEnd.load(memory_order_acquire) ? n->freq.load(memory_order_relaxed) : 0;
+    }
+
+    // Autocomplete: all words with given prefix, sorted
+    vector<string> autocomplete(const string& prefix) const {
+        EpochGuard g;
+        vector<string> results;
+        const ConcurrentTrieNode* n = find(prefix);
+        if (!n) return results;
+        string current = prefix;
+        collectWords(n, current, results);
+        return results;
+    }
+
+    int size() const { return totalWords.load(); }
+};
+
+// -- Benchmarks -------------------------------------------------------------
+// Pronounceable pseudo-English words with Zipf-like insert counts
+vector<pair<string, int>> makeDictionary(int n, unsigned seed) {
+    static const vector<string> syllables = {
+        "an","ar","be","ca","con","de","di","en","er","ex","fa","for","ge","in",
+        "ing","ion","is","ka","la","le","ly","ma","men","mo","ne","ni","or","pa",
+        "per","pro","qu","ra","re","ri","ro","sa","se","st","ta","te","ter","ti",
+        "to","tr","un","ur","va","ve","wa","zy"
+    };
+    mt19937 rng(seed);
+    uniform_int_distribution<int> len(1, 5), pick(0, (int)syllables.size() - 1);
+    vector<pair<string, int>> dict;
+    dict.reserve(n);
+    for (int i = 0; i < n; i++) {
+        string w;
+        int parts = len(rng);
+        for (int j = 0; j < parts; j++) w += syllables[pick(rng)];
+        dict.push_back({w, 1 + 1000 / (1 + i % 997)});
+    }
+    return dict;
+}
+
+void benchmarkCompactTrie(int n) {
+    auto dict = makeDictionary(n, 42);
+    auto t0 = chrono::steady_clock::now();
+    Trie trie;
+    for (const auto& [w, f] : dict)
+        for (int i = 0; i < f; i++) trie.insert(w);
+    auto t1 = chrono::steady_clock::now();
+    CompactTrie compact(trie.entries());
+    auto t2 = chrono::steady_clock::now();
+
+    // Half hits, half near-misses
+    vector<string> queries;
+    auto misses = makeDictionary(n, 7);
+    for (int i = 0; i < n; i++) queries.push_back(i % 2 ? dict[i].first : misses[i].first + "q");
+
+    auto lookups = [&](auto& t) {
+        int found = 0;
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < 5; r++)
+            for (const auto& q : queries) found += t.search(q);
+        double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return make_pair(found, 5.0 * queries.size() / s);
+    };
+    auto [foundTrie, rateTrie] = lookups(trie);
+    auto [foundCompact, rateCompact] = lookups(compact);
+
+    double ms1 = chrono::duration<double, milli>(t1 - t0).count();
+    double ms2 = chrono::duration<double, milli>(t2 - t1).count();
+    int words = trie.size();
+    cout << n << " generated words, " << words << " distinct\n";
+    cout << left << setw(14) << "" << right << setw(10) << "nodes" << setw(14) << "bytes/word"
+         << setw(14) << "build ms" << setw(16) << "lookups/sec\n";
+    cout << fixed << setprecision(1);
+    cout << left << setw(14) << "Trie" << right << setw(10) << trie.nodeCount()
+         << setw(14) << (double)trie.memoryBytes() / words << setw(14) << ms1
+         << setw(15) << rateTrie / 1e6 << "M\n";
+    cout << left << setw(14) << "CompactTrie" << right << setw(10) << compact.nodeCount()
+         << setw(14) << (double)compact.memoryBytes() / words << setw(14) << ms2
+         << setw(15) << rateCompact / 1e6 << "M\n";
+    cout << "Found " << foundTrie << " / " << foundCompact << " (must match)\n";
+}
+
+void benchmarkTopK(int n, int k) {
+    Trie trie;
+    for (const auto& [w, f] : makeDictionary(n, 42))
+        for (int i = 0; i < f; i++) trie.insert(w);
+
+    // Baseline: collect the whole subtree, then rank it
+    auto fullScan = [&](const string& prefix) {
+        vector<pair<string, int>> ranked;
+        for (const auto& w : trie.autocomplete(prefix)) ranked.push_back({w, trie.frequency(w)});
+        sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        if ((int)ranked.size() > k) ranked.resize(k);
+        return ranked;
+    };
+
+    cout << trie.size() << " words, k = " << k << "\n";
+    cout << left << setw(8) << "prefix" << right << setw(12) << "subtree" << setw(16)
+         << "collect+sort us" << setw(14) << "topK us" << setw(10) << "same\n";
+    for (const string prefix : {"c", "pro", "re", "conter"}) {
+        int reps = 20;
+        vector<pair<string, int>> a, b;
+        auto t0 = chrono::steady_clock::now();
+        for (int r = 0; r < reps; r++) a = fullScan(prefix);
+        auto t1 = chrono::steady_clock::now();
+        for (int r = 0; r < reps; r++) b = trie.autocompleteTopK(prefix, k);
+        auto t2 = chrono::steady_clock::now();
+        cout << left << setw(8) << prefix << right << setw(12) << trie.countWithPrefix(prefix)
+             << fixed << setprecision(1)
+             << setw(16) << chrono::duration<double, micro>(t1 - t0).count() / reps
+             << setw(14) << chrono::duration<double, micro>(t2 - t1).count() / reps
+             << setw(9) << (a == b ? "yes" : "NO") << "\n";
+    }
+}
+
+// URLs with mixed case, digits, punctuation and some UTF-8 path segments
+vector<string> makeUrls(int n, unsigned seed) {
+    static const vector<string> hosts = {
+        "example.com","shop.example.com","api.Example.org","cdn-7.static.net",
+        "news.site.io","m.wiki.org","docs.dev","b\xC3\xBC" "cher.de"
+    };
+    static const vector<string> parts = {
+        "users","v2","items","search","img","Product","caf\xC3\xA9","2024",
+        "reviews","cart","\xE6\x97\xA5\xE6\x9C\xAC","help","a_b","index.html"
+    };
+    mt19937 rng(seed);
+    vector<string> urls;
+    urls.reserve(n);
+    for (int i = 0; i < n; i++) {
+        string u = (rng() % 4 ? "https://" : "http://") + hosts[rng() % hosts.size()];
+        int depth = 1 + rng() % 4;
+        for (int d = 0; d < depth; d++) u += "/" + parts[rng() % parts.size()];
+        if (rng() % 2) u += "?id=" + to_string(rng() % 100000);
+        urls.push_back(u);
+    }
+    return urls;
+}
+
+void benchmarkByteTrie(int n) {
+    auto report = [](const string& name, size_t nodes, size_t bytes, int words,
+                     double buildMs, double rate) {
+        cout << left << setw(24) << name << right << setw(10) << nodes
+             << fixed << setprecision(1) << setw(12) << (double)bytes / words
+             << setw(11) << buildMs << setw(13) << rate / 1e6 << "M\n";
+    };
+    auto timeLookups = [](auto& t, const vector<string>& qs) {
+        int found = 0;
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < 3; r++)
+            for (const auto& q : qs) found += t.search(q);
+        double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return make_pair(found / 3, 3.0 * qs.size() / s);
+    };
+    auto header = [] {
+        cout << left << setw(24) << "" << right << setw(10) << "nodes" << setw(12)
+             << "bytes/word" << setw(11) << "build ms" << setw(14) << "lookups/sec\n";
+    };
+
+    vector<string> english;
+    for (const auto& e : makeDictionary(n, 42)) english.push_back(e.first);
+    vector<string> misses;
+    for (const auto& e : makeDictionary(n, 7)) misses.push_back(e.first + "q");
+    vector<string> queries;
+    for (int i = 0; i < n; i++) queries.push_back(i % 2 ? english[i] : misses[i]);
+
+    cout << "English-like corpus (" << n << " words)\n";
+    header();
+    auto t0 = chrono::steady_clock::now();
+    Trie trie;
+    for (const auto& w : english) trie.insert(w);
+    auto t1 = chrono::steady_clock::now();
+    ByteTrie bt;
+    for (const auto& w : english) bt.insert(w);
+    auto t2 = chrono::steady_clock::now();
+    auto [f1, r1] = timeLookups(trie, queries);
+    auto [f2, r2] = timeLookups(bt, queries);
+    report("Trie (26-ary)", trie.nodeCount(), trie.memoryBytes(), trie.size(),
+           chrono::duration<double, milli>(t1 - t0).count(), r1);
+    report("ByteTrie (sparse/dense)", bt.nodeCount(), bt.memoryBytes(), bt.size(),
+           chrono::duration<double, milli>(t2 - t1).count(), r2);
+    cout << "Found " << f1 << " / " << f2 << " (must match)\n";
+
+    // Trie::idx() cannot index these bytes; a flat 256-pointer node is the naive alternative
+    auto urls = makeUrls(n, 9);
+    vector<string> urlQueries;
+    for (int i = 0; i < n; i++) urlQueries.push_back(i % 2 ? urls[i] : urls[i] + "#x");
+    cout << "\nURL corpus (" << n << " URLs)\n";
+    header();
+    t0 = chrono::steady_clock::now();
+    ByteTrie ut;
+    for (const auto& u : urls) ut.insert(u);
+    t1 = chrono::steady_clock::now();
+    auto [f3, r3] = timeLookups(ut, urlQueries);
+    size_t flat = ut.nodeCount() * (256 * sizeof(void*) + 3 * sizeof(int));
+    cout << left << setw(24) << "Trie (26-ary)" << right << setw(10) << "n/a"
+         << "  (bytes outside a-z)\n";
+    cout << left << setw(24) << "256-ary node (estimate)" << right << setw(10) << ut.nodeCount()
+         << setw(12) << (double)flat / ut.size() << "\n";
+    report("ByteTrie (sparse/dense)", ut.nodeCount(), ut.memoryBytes(), ut.size(),
+           chrono::duration<double, milli>(t1 - t0).count(), r3);
+    cout << "Found " << f3 << " of " << urlQueries.size() << " (half are misses)\n";
+}
+
+// Full O(n*m) table, as in EditDistanceLevenshteinAlgorithmDynamicProgramming.cpp
+int editDistance(const string& word1, const string& word2) {
+    int n = word1.size();
+    int m = word2.size();
+    vector<vector<int>> dp(n + 1, vector<int>(m + 1, 0));
+    for (int i = 0; i <= n; i++) dp[i][0] = i;
+    for (int j = 0; j <= m; j++) dp[0][j] = j;
+    for (int i = 1; i <= n; i++) {
+        for (int j = 1; j <= m; j++) {
+            if (word1[i - 1] == word2[j - 1]) dp[i][j] = dp[i - 1][j - 1];
+            else dp[i][j] = 1 + min(dp[i - 1][j], min(dp[i][j - 1], dp[i - 1][j - 1]));
+        }
+    }
+    return dp[n][m];
+}
+
+// Typo queries: fuzzySearch vs editDistance against every dictionary word
+void benchmarkFuzzySearch(int n, int numQueries) {
+    Trie trie;
+    for (const auto& e : makeDictionary(n, 42)) trie.insert(e.first);
+    auto entries = trie.entries();
+
+    // Misspell real words: one random substitution, deletion or insertion
+    mt19937 rng(3);
+    vector<string> queries;
+    for (int i = 0; i < numQueries; i++) {
+        string w = entries[rng() % entries.size()].first;
+        size_t pos = rng() % w.size();
+        char c = (char)('a' + rng() % 26);
+        switch (rng() % 3) {
+            case 0: w[pos] = c; break;
+            case 1: if (w.size() > 1) w.erase(pos, 1); break;
+            default: w.insert(w.begin() + pos, c);
+        }
+        queries.push_back(w);
+    }
+
+    cout << entries.size() << " words, " << numQueries << " misspelled queries\n";
+    cout << left << setw(9) << "maxDist" << right << setw(16) << "brute force us" << setw(16)
+         << "fuzzySearch us" << setw(10) << "matches" << setw(8) << "same\n";
+    for (int maxDist : {1, 2}) {
+        vector<vector<pair<string, int>>> brute(queries.size()), fuzzy(queries.size());
+        auto t0 = chrono::steady_clock::now();
+        for (size_t q = 0; q < queries.size(); q++) {
+            for (const auto& e : entries) {
+                int d = editDistance(queries[q], e.first);
+                if (d <= maxDist) brute[q].push_back({e.first, d});
+            }
+            sort(brute[q].begin(), brute[q].end(), [](const auto& a, const auto& b) {
+                return a.second != b.second ? a.second < b.second : a.first < b.first;
+            });
+        }
+        auto t1 = chrono::steady_clock::now();
+        for (size_t q = 0; q < queries.size(); q++) fuzzy[q] = trie.fuzzySearch(queries[q], maxDist);
+        auto t2 = chrono::steady_clock::now();
+        size_t matches = 0;
+        for (const auto& r : fuzzy) matches += r.size();
+        cout << left << setw(9) << maxDist << right << fixed << setprecision(1)
+             << setw(16) << chrono::duration<double, micro>(t1 - t0).count() / queries.size()
+             << setw(16) << chrono::duration<double, micro>(t2 - t1).count() / queries.size()
+             << setw(10) << matches << setw(7) << (brute == fuzzy ? "yes" : "NO") << "\n";
+    }
+}
+
+// Resident set size in KB (Linux /proc); 0 where unavailable
+size_t residentKB() {
+#ifdef __linux__
+    ifstream in("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    in >> pages >> resident;
+    return resident * (size_t)sysconf(_SC_PAGESIZE) / 1024;
+#else
+    return 0;
+#endif
+}
+
+// Startup: insert every word into a Trie vs mmap a prebuilt image
+void benchmarkTrieImage(int n) {
+    string path = (filesystem::temp_directory_path() / "trie_image_bench.bin").string();
+    auto dict = makeDictionary(n, 42);
+    vector<string> queries;
+    for (int i = 0; i < n; i += 7) queries.push_back(dict[i].first);
+    long long sink = 0;
+
+    // Measured first, so the RSS delta is not hidden by memory freed earlier
+    size_t rss0 = residentKB();
+    auto t0 = chrono::steady_clock::now();
+    Trie trie;
+    for (const auto& [w, f] : dict)
+        for (int i = 0; i < f; i++) trie.insert(w);
+    sink += trie.countWithPrefix("pro");
+    double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    double rssTrie = (double)residentKB() - rss0;
+    auto t1 = chrono::steady_clock::now();
+    for (const auto& q : queries) sink += trie.search(q);
+    double trieNs = chrono::duration<double, nano>(chrono::steady_clock::now() - t1).count() / queries.size();
+
+    t0 = chrono::steady_clock::now();
+    CompactTrie(dict).saveImage(path);   // offline builder step
+    double saveMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    size_t fileBytes;
+    double mapMs, imageNs, rssFirst, rssAll;
+    {
+        size_t rss1 = residentKB();
+        t0 = chrono::steady_clock::now();
+        TrieImage img(path);
+        sink += img.countWithPrefix("pro");
+        mapMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        rssFirst = (double)residentKB() - rss1;
+        t1 = chrono::steady_clock::now();
+        for (const auto& q : queries) sink += img.search(q);
+        imageNs = chrono::duration<double, nano>(chrono::steady_clock::now() - t1).count() / queries.size();
+        rssAll = (double)residentKB() - rss1;
+        fileBytes = img.fileBytes();
+    }
+    filesystem::remove(path);
+
+    cout << n << " words (" << trie.size() << " distinct), image " << fileBytes / 1024
+         << " KB written in " << fixed << setprecision(1) << saveMs << " ms\n";
+    cout << "  Trie, insert at startup : " << setw(9) << buildMs << " ms to first answer, RSS +"
+         << rssTrie / 1024 << " MB, " << trieNs << " ns/search\n";
+    cout << "  TrieImage, mmap         : " << setw(9) << setprecision(3) << mapMs
+         << " ms to first answer, RSS +" << setprecision(1) << rssFirst / 1024 << " MB ("
+         << rssAll / 1024 << " MB after " << queries.size() << " searches), "
+         << imageNs << " ns/search\n";
+    cout << "  (image file is in the page cache; checksum " << sink << ")\n";
+}
+
+// Readers check invariants while writers churn their own word sets
+void stressConcurrentTrie(int readers, int writers, int cycles) {
+    vector<string> stable;
+    for (const auto& e : makeDictionary(3000, 42)) stable.push_back(e.first);
+    sort(stable.begin(), stable.end());
+    stable.erase(unique(stable.begin(), stable.end()), stable.end());
+    vector<vector<string>> owned(writers);
+    for (int w = 0; w < writers; w++)
+        for (const auto& e : makeDictionary(1000, 100 + w)) owned[w].push_back(e.first + string(1, 'x' + w % 3) + string(w / 3 + 1, 'q'));
+    for (auto& words : owned) {
+        sort(words.begin(), words.end());
+        words.erase(unique(words.begin(), words.end()), words.end());
+    }
+
+    ConcurrentTrie trie;
+    for (const auto& w : stable) trie.insert(w);
+    int stableUnderCa = trie.countWithPrefix("ca");
+
+    atomic<bool> done(false);
+    atomic<long long> reads(0), violations(0);
+    vector<thread> pool;
+    for (int r = 0; r < readers; r++) {
+        pool.emplace_back([&, r] {
+            mt19937 rng(r);
+            long long n = 0;
+            while (!done.load()) {
+                const string& w = stable[rng() % stable.size()];
+                if (!trie.search(w) || trie.frequency(w) < 1) violations++;
+                if (trie.countWithPrefix("ca") < stableUnderCa) violations++;
+                if (n % 64 == 0) trie.autocomplete(w.substr(0, 3));
+                n++;
+            }
+            reads += n;
+        });
+    }
+    // Each cycle: insert every owned word, then remove the odd ones
+    for (int w = 0; w < writers; w++) {
+        pool.emplace_back([&, w] {
+            for (int c = 0; c < cycles; c++) {
+                for (const auto& word : owned[w]) trie.insert(word);
+                for (size_t i = 1; i < owned[w].size(); i += 2) trie.remove(owned[w][i]);
+            }
+        });
+    }
+    for (int i = readers; i < readers + writers; i++) pool[i].join();
+    done = true;
+    for (int i = 0; i < readers; i++) pool[i].join();
+
+    // Expected: stable words once, even owned words `cycles` times, odd ones gone
+    Trie reference;
+    for (const auto& w : stable) reference.insert(w);
+    for (const auto& words : owned)
+        for (size_t i = 0; i < words.size(); i += 2)
+            for (int c = 0; c < cycles; c++) reference.insert(words[i]);
+    int mismatches = 0;
+    for (const auto& words : owned)
+        for (size_t i = 0; i < words.size(); i++)
+            if (trie.search(words[i]) != (i % 2 == 0) ||
+                trie.frequency(words[i]) != reference.frequency(words[i])) mismatches++;
+    for (const string p : {"a", "ca", "pro", "re", "st", "zy"})
+        if (trie.countWithPrefix(p) != reference.countWithPrefix(p)) mismatches++;
+    if (trie.size() != reference.size()) mismatches++;
+
+    cout << readers << " readers, " << writers << " writers x " << cycles << " cycles: "
+         << reads.load() << " reads, " << violations.load() << " invariant violations, "
+         << mismatches << " final mismatches, " << trie.size() << " words\n";
+}
+
+// Mixed 90% search / 10% insert+remove, ConcurrentTrie vs Trie behind one mutex
+void benchmarkConcurrentTrie(int opsPerThread) {
+    vector<string> dict;
+    for (const auto& e : makeDictionary(100000, 42)) dict.push_back(e.first);
+    cout << "hardware threads: " << thread::hardware_concurrency() << "\n";
+    cout << left << setw(9) << "threads" << right << setw(19) << "Trie+mutex Mops/s"
+         << setw(24) << "ConcurrentTrie Mops/s\n";
+
+    atomic<long long> hits(0);   // keeps the searches from being optimized away
+    for (int threads : {1, 2, 4, 8}) {
+        auto run = [&](auto search, auto insert, auto remove) {
+            auto start = chrono::steady_clock::now();
+            vector<thread> pool;
+            for (int t = 0; t < threads; t++) {
+                pool.emplace_back([&, t] {
+                    mt19937 rng(t);
+                    string mine = "zz" + string(1, 'a' + t);
+                    long long found = 0;
+                    for (int i = 0; i < opsPerThread; i++) {
+                        if (i % 10 == 0) {
+                            string w = mine + dict[rng() % dict.size()];
+                            if (i % 20 == 0) insert(w); else remove(w);
+                        } else {
+                            found += search(dict[rng() % dict.size()]);
+                        }
+                    }
+                    hits += found;
+                });
+            }
+            for (auto& th : pool) th.join();
+            double s = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            return threads * (double)opsPerThread / s / 1e6;
+        };
+
+        Trie locked;
+        mutex lock;
+        for (const auto& w : dict) locked.insert(w);
+        double a = run([&](const string& w) { lock_guard<mutex> lk(lock); return locked.search(w); },
+                       [&](const string& w) { lock_guard<mutex> lk(lock); locked.insert(w); },
+                       [&](const string& w) { lock_guard<mutex> lk(lock); locked.remove(w); });
+        ConcurrentTrie conc;
+        for (const auto& w : dict) conc.insert(w);
+        double b = run([&](const string& w) { return conc.search(w); },
+                       [&](const string& w) { conc.insert(w); },
+                       [&](const string& w) { conc.remove(w); });
+        cout << left << setw(9) << threads << right << fixed << setprecision(2)
+             << setw(19) << a << setw(23) << b << "\n";
+    }
+}
+
 // -- Demos ------------------------------------------------------------------
 void sep(const string& t) {
     cout << "\n" << string(52, '-') << "\n " << t << "\n" << string(52, '-') << "\n";
@@ -288,5 +1737,97 @@ int main() {
     vis.insert("bat"); vis.insert("ball");
     vis.printStructure();
 
+    sep("11. Compact Radix Trie");
+    CompactTrie compact(trie.entries());
+    cout << "Built from " << trie.size() << " words: " << compact.nodeCount() << " nodes ("
+         << trie.nodeCount() << " in Trie), " << compact.memoryBytes() << " bytes ("
+         << trie.memoryBytes() << " in Trie)\n";
+    for (const auto& w : {"apple","App","ban","bandana","CARD","xyz"}) {
+        cout << "search(\"" << w << "\") = " << (compact.search(w) ? "FOUND" : "NOT FOUND")
+             << ", startsWith = " << (compact.startsWith(w) ? "YES" : "NO")
+             << ", countWithPrefix = " << compact.countWithPrefix(w)
+             << ", freq = " << compact.frequency(w) << "\n";
+    }
+    printVec(compact.autocomplete("ba"), "autocomplete(\"ba\")");
+    printVec(compact.autocomplete("do"), "autocomplete(\"do\")");
+    CompactTrie emptyCompact(Trie().entries());
+    cout << "Empty input: " << emptyCompact.size() << " words, " << emptyCompact.nodeCount()
+         << " node, search(\"a\") = " << (emptyCompact.search("a") ? "FOUND" : "NOT FOUND")
+         << ", countWithPrefix(\"\") = " << emptyCompact.countWithPrefix("") << "\n";
+
+    sep("12. Benchmark: Trie vs CompactTrie");
+    benchmarkCompactTrie(300000);
+
+    sep("13. Top-K Autocomplete");
+    trie.insert("band"); trie.insert("band"); trie.insert("bank");
+    for (const auto& p : {"ba","a","c"}) {
+        cout << "autocompleteTopK(\"" << p << "\", 3): ";
+        for (const auto& [w, f] : trie.autocompleteTopK(p, 3)) cout << w << "(" << f << ") ";
+        cout << "\n";
+    }
+
+    sep("14. Benchmark: Top-K vs collect + sort");
+    benchmarkTopK(300000, 10);
+
+    sep("15. Byte Trie (UTF-8, digits, punctuation)");
+    ByteTrie bt;
+    for (const auto& w : {"iPhone 15 Pro","iPhone 15","iPad Air (5th gen)","Caf\xC3\xA9 cr\xC3\xA8me",
+                          "Caf\xC3\xA9 noir","https://shop.example.com/item?id=42","C++17","C#"})
+        bt.insert(w);
+    bt.insert("iPhone 15");
+    cout << "search(\"C++17\") = " << (bt.search("C++17") ? "FOUND" : "NOT FOUND") << "\n";
+    cout << "freq(\"iPhone 15\") = " << bt.frequency("iPhone 15") << "\n";
+    cout << "countWithPrefix(\"iP\") = " << bt.countWithPrefix("iP") << "\n";
+    printVec(bt.autocomplete("Caf\xC3\xA9"), "autocomplete(\"Caf\xC3\xA9\")");
+    printVec(bt.autocomplete("C"), "autocomplete(\"C\")");
+    bt.remove("iPhone 15");
+    printVec(bt.autocomplete("iPhone"), "autocomplete(\"iPhone\") after removing 'iPhone 15'");
+
+    sep("16. Benchmark: ByteTrie vs 26-ary Trie");
+    benchmarkByteTrie(200000);
+
+    sep("17. Concurrent Trie (lock-free reads)");
+    ConcurrentTrie ct;
+    for (const auto& w : words) ct.insert(w);
+    ct.insert("band");
+    cout << "search(band) = " << (ct.search("band") ? "FOUND" : "NOT FOUND")
+         << ", freq = " << ct.frequency("band") << ", countWithPrefix(ban) = "
+         << ct.countWithPrefix("ban") << "\n";
+    ct.remove("band");
+    cout << "after remove(band): countWithPrefix(ban) = " << ct.countWithPrefix("ban") << "\n";
+    printVec(ct.autocomplete("ban"), "autocomplete(\"ban\")");
+    stressConcurrentTrie(4, 3, 20);
+
+    sep("18. Benchmark: ConcurrentTrie vs Trie + mutex");
+    benchmarkConcurrentTrie(200000);
+
+    sep("19. Memory-mapped Trie image");
+    string imagePath = (filesystem::temp_directory_path() / "trie_demo.img").string();
+    CompactTrie(trie.entries()).saveImage(imagePath);
+    {
+        TrieImage img(imagePath);
+        cout << "Mapped " << img.fileBytes() << " bytes, " << img.size() << " words\n";
+        for (const auto& w : {"apple","ban","card","xyz"}) {
+            cout << "search(\"" << w << "\") = " << (img.search(w) ? "FOUND" : "NOT FOUND")
+                 << ", startsWith = " << (img.startsWith(w) ? "YES" : "NO")
+                 << ", countWithPrefix = " << img.countWithPrefix(w) << "\n";
+        }
+        printVec(img.autocomplete("do"), "autocomplete(\"do\")");
+    }
+    filesystem::remove(imagePath);
+
+    sep("20. Benchmark: cold start, Trie inserts vs TrieImage mmap");
+    benchmarkTrieImage(1000000);
+
+    sep("21. Fuzzy Search (bounded edit distance)");
+    for (const auto& [q, d] : vector<pair<string, int>>{{"aple", 1}, {"bandanna", 1}, {"cart", 1}, {"dgo", 2}}) {
+        cout << "fuzzySearch(\"" << q << "\", " << d << "): ";
+        for (const auto& [w, dist] : trie.fuzzySearch(q, d)) cout << w << "(" << dist << ") ";
+        cout << "\n";
+    }
+
+    sep("22. Benchmark: fuzzySearch vs brute-force edit distance");
+    benchmarkFuzzySearch(50000, 50);
+
     return 0;
 }
\ No newline at end of file
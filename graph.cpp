@@ -8,40 +8,581 @@
 #include <algorithm>
 #include <iomanip>
 #include <functional>
+#include <type_traits>
+#include <random>
+#include <chrono>
+#include <numeric>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
+// -- Weighted shortest paths ------------------------------------------------
+// Result of a single-source search: dist[v] is kUnreachable when v cannot be
+// reached, parent[v] is the previous vertex on one shortest path (-1 for the
+// source and unreachable vertices).
+struct ShortestPaths {
+    static constexpr long long kUnreachable = numeric_limits<long long>::max();
+    vector<long long> dist;
+    vector<int>       parent;
+
+    vector<int> pathTo(int v) const {
+        if (dist[v] == kUnreachable) return {};
+        vector<int> path;
+        for (int cur = v; cur != -1; cur = parent[cur]) path.push_back(cur);
+        reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+// 4-ary min-heap of vertex ids keyed by distance. pos[v] tracks where v sits,
+// so decreaseKey sifts it up in place instead of pushing a duplicate entry;
+// the heap never holds more than one entry per vertex.
+class IndexedMinHeap {
+    static constexpr int kArity = 4;
+    vector<int>       heap;
+    vector<int>       pos;  // -1 = not in the heap
+    vector<long long> key;
+
+    void place(int i, int v) { heap[i] = v; pos[v] = i; }
+
+    void siftUp(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int p = (i - 1) / kArity;
+            if (key[heap[p]] <= key[v]) break;
+            place(i, heap[p]);
+            i = p;
+        }
+        place(i, v);
+    }
+
+    void siftDown(int i) {
+        int v = heap[i], n = (int)heap.size();
+        while (true) {
+            int first = i * kArity + 1;
+            if (first >= n) break;
+            int best = first;
+            for (int c = first + 1; c < min(n, first + kArity); c++)
+                if (key[heap[c]] < key[heap[best]]) best = c;
+            if (key[heap[best]] >= key[v]) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, v);
+    }
+
+public:
+    explicit IndexedMinHeap(int n) : pos(n, -1), key(n) {}
+
+    bool empty() const { return heap.empty(); }
+    bool contains(int v) const { return pos[v] >= 0; }
+
+    void push(int v, long long k) {
+        key[v] = k;
+        heap.push_back(v);
+        siftUp((int)heap.size() - 1);
+    }
+
+    void decreaseKey(int v, long long k) {
+        key[v] = k;
+        siftUp(pos[v]);
+    }
+
+    // Removes and returns the vertex with the smallest key
+    int popMin() {
+        int top = heap[0];
+        pos[top] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) { place(0, last); siftDown(0); }
+        return top;
+    }
+};
+
+// -- Connected components ---------------------------------------------------
+// label[v] is a dense component id in [0, count), numbered in order of each
+// component's smallest vertex; sizes[c] is the number of vertices in c.
+struct Components {
+    vector<int> label;
+    vector<int> sizes;
+    int count() const { return (int)sizes.size(); }
+};
+
+// -- Edge-list files --------------------------------------------------------
+class MappedFile {
+private:
+    const char* data;
+    size_t      len;
+    string      buffer;   // fallback storage when mmap is unavailable
+
+public:
+    explicit MappedFile(const string& path) : data(nullptr), len(0) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("Cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) { close(fd); throw runtime_error("Cannot stat " + path); }
+        len = (size_t)st.st_size;
+        if (len > 0) {
+            void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) { close(fd); throw runtime_error("Cannot mmap " + path); }
+            data = static_cast<const char*>(p);
+            madvise(p, len, MADV_SEQUENTIAL);
+        }
+        close(fd);
+#else
+        ifstream in(path, ios::binary);
+        if (!in) throw runtime_error("Cannot open " + path);
+        buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        data = buffer.data();
+        len  = buffer.size();
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (data) munmap(const_cast<char*>(data), len);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return data; }
+    size_t      size() const { return len; }
+
+    // Drop the pages wholly inside [lo, hi) from this process's resident set;
+    // they stay in the page cache and fault back in if touched again
+    void release(size_t lo, size_t hi) const {
+#if defined(__unix__) || defined(__APPLE__)
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        lo = (lo + page - 1) / page * page;
+        hi = min(hi, len) / page * page;
+        if (data && lo < hi) madvise(const_cast<char*>(data) + lo, hi - lo, MADV_DONTNEED);
+#else
+        (void)lo; (void)hi;
+#endif
+    }
+};
+
+// Binary layout (native byte order): EdgeListHeader, then edgeCount records
+// of int32 {u, v}, or {u, v, w} when weighted. Text files hold one "u v" or
+// "u v w" per line with vertex ids from 0; lines starting with '#' or '%'
+// are comments (SNAP / Matrix Market headers).
+struct EdgeListHeader {
+    char     magic[8];      // "EDGELST"
+    uint32_t version;       // 1
+    uint32_t weighted;      // 0 or 1
+    uint64_t vertexCount;
+    uint64_t edgeCount;
+};
+
+// -- Worker pool ------------------------------------------------------------
+// Fixed set of worker threads reused by every parallel round of one
+// algorithm call. run(n, fn) hands out fn(0..n-1) to the workers and the
+// calling thread, and returns once all n calls have finished.
+class WorkerPool {
+    vector<thread>               workers;
+    mutex                        lock;
+    condition_variable           wake, finished;
+    const function<void(int)>*   job = nullptr;
+    int                          tasks = 0;
+    atomic<int>                  nextTask{0};
+    size_t                       busy = 0;         // workers still inside the current job
+    uint64_t                     generation = 0;   // bumped once per run()
+    bool                         stopping = false;
+
+    void drain(const function<void(int)>& fn) {
+        for (int t; (t = nextTask.fetch_add(1)) < tasks; ) fn(t);
+    }
+
+    void workerLoop() {
+        uint64_t seen = 0;
+        unique_lock<mutex> lk(lock);
+        while (true) {
+            wake.wait(lk, [&]{ return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            const function<void(int)>& fn = *job;
+            lk.unlock();
+            drain(fn);
+            lk.lock();
+            if (--busy == 0) finished.notify_one();
+        }
+    }
+
+public:
+    explicit WorkerPool(int threads) {
+        for (int t = 1; t < threads; t++) workers.emplace_back([this]{ workerLoop(); });
+    }
+
+    ~WorkerPool() {
+        { lock_guard<mutex> lk(lock); stopping = true; }
+        wake.notify_all();
+        for (auto& th : workers) th.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return (int)workers.size() + 1; }
+
+    void run(int n, const function<void(int)>& fn) {
+        {
+            lock_guard<mutex> lk(lock);
+            job   = &fn;
+            tasks = n;
+            nextTask.store(0);
+            busy  = workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        drain(fn);
+        unique_lock<mutex> lk(lock);
+        finished.wait(lk, [&]{ return busy == 0; });
+    }
+};
+
 // -- Generic Graph (directed or undirected, weighted or unweighted) ---------
+// Edges are collected in per-vertex lists while the graph is being built.
+// freeze() packs them into compressed sparse row (CSR) form: the edges of u
+// are targets/weights[offsets[u] .. offsets[u+1]), three flat arrays that a
+// traversal streams through instead of chasing one heap block per vertex.
+// Every traversal goes through scanNeighbors(), so it runs on CSR once the
+// graph is frozen; addEdge() on a frozen graph unpacks it again.
 class Graph {
 private:
     int  vertices;
     bool directed;
-    vector<vector<pair<int,int>>> adj; // adj[u] = {v, weight}
+    vector<vector<pair<int,int>>> adj; // adj[u] = {v, weight}, while not frozen
+
+    bool        frozen = false;
+    vector<int> offsets;               // size vertices + 1
+    vector<int> targets;
+    vector<int> weights;
+    vector<int> inOffsets;             // directed only: reverse CSR for bottom-up BFS
+    vector<int> inSources;
+
+    // Incremental connectivity: a union-find over every edge added since
+    // trackConnectivity(). findRoot() halves paths, hence mutable.
+    bool                tracking = false;
+    mutable vector<int> dsuParent;
+    vector<int>         dsuSize;
+    int                 trackedComponents = 0;
+    bool                cycleSeen = false; // undirected: some edge joined one component
+
+    int findRoot(int v) const {
+        while (dsuParent[v] != v) {
+            dsuParent[v] = dsuParent[dsuParent[v]];
+            v = dsuParent[v];
+        }
+        return v;
+    }
+
+    // Union by size: the smaller tree hangs under the larger root. An
+    // undirected edge inside one component closes a cycle.
+    void unite(int u, int v) {
+        int ru = findRoot(u), rv = findRoot(v);
+        if (ru == rv) { cycleSeen |= !directed; return; }
+        if (dsuSize[ru] < dsuSize[rv]) swap(ru, rv);
+        dsuParent[rv] = ru;
+        dsuSize[ru] += dsuSize[rv];
+        trackedComponents--;
+    }
+
+    // Run fn(thread, lo, hi) over [0, total) in blocks handed out dynamically,
+    // so skewed work (power-law degrees) still spreads across threads.
+    // thread is in [0, pool.size()) and no two concurrent calls share one.
+    template<typename F>
+    static void forBlocks(WorkerPool& pool, size_t total, size_t block, F&& fn) {
+        if (pool.size() <= 1 || total <= block) { fn(0, 0, total); return; }
+        atomic<size_t> nextBlock(0);
+        pool.run(pool.size(), [&](int t) {
+            for (size_t lo; (lo = nextBlock.fetch_add(block)) < total;)
+                fn(t, lo, min(total, lo + block));
+        });
+    }
+
+    // Calls f(v, w) for every edge u -> v in insertion order. If f returns
+    // bool, true stops the scan early and scanNeighbors returns true.
+    template<typename F>
+    bool scanNeighbors(int u, F&& f) const {
+        constexpr bool stops = is_same_v<invoke_result_t<F&, int, int>, bool>;
+        if (frozen) {
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                if constexpr (stops) { if (f(targets[e], weights[e])) return true; }
+                else f(targets[e], weights[e]);
+            }
+        } else {
+            for (auto [v, w] : adj[u]) {
+                if constexpr (stops) { if (f(v, w)) return true; }
+                else f(v, w);
+            }
+        }
+        return false;
+    }
+
+    // In-edge CSR (inOffsets/inSources) from the out-edge arrays
+    void buildReverse() {
+        inOffsets.assign(vertices + 1, 0);
+        for (int v : targets) inOffsets[v + 1]++;
+        partial_sum(inOffsets.begin(), inOffsets.end(), inOffsets.begin());
+        inSources.resize(targets.size());
+        vector<int> fillAt(inOffsets.begin(), inOffsets.end() - 1);
+        for (int u = 0; u < vertices; u++)
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) inSources[fillAt[targets[e]]++] = u;
+    }
+
+    void thaw() {
+        adj.assign(vertices, {});
+        for (int u = 0; u < vertices; u++) {
+            adj[u].reserve(offsets[u + 1] - offsets[u]);
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) adj[u].push_back({targets[e], weights[e]});
+        }
+        vector<int>().swap(offsets);
+        vector<int>().swap(targets);
+        vector<int>().swap(weights);
+        vector<int>().swap(inOffsets);
+        vector<int>().swap(inSources);
+        frozen = false;
+    }
 
 public:
     explicit Graph(int v, bool directed = false)
         : vertices(v), directed(directed), adj(v) {}
 
     void addEdge(int u, int v, int w = 1) {
+        if (frozen) thaw();
         adj[u].push_back({v, w});
         if (!directed) adj[v].push_back({u, w});
+        if (tracking) unite(u, v);
+    }
+
+    // Keep a union-find in step with addEdge(), so connected(),
+    // wouldCreateCycle(), countComponents() and hasCycleUndirected() cost
+    // O(alpha(n)) instead of a traversal. Edges already in the graph are
+    // folded in once, O(E); an undirected edge is stored both ways, so only
+    // the copy with u <= v is folded.
+    // Queries compress paths, so they must not run concurrently.
+    // Edges cannot be removed, so there is no deletion to support.
+    void trackConnectivity() {
+        if (tracking) return;
+        dsuParent.resize(vertices);
+        iota(dsuParent.begin(), dsuParent.end(), 0);
+        dsuSize.assign(vertices, 1);
+        trackedComponents = vertices;
+        cycleSeen = false;
+        for (int u = 0; u < vertices; u++)
+            scanNeighbors(u, [&](int v, int) { if (directed || u <= v) unite(u, v); });
+        tracking = true;
+    }
+
+    bool tracksConnectivity() const { return tracking; }
+
+    // Whether u and v are in one component (weakly, for a directed graph)
+    bool connected(int u, int v) const {
+        if (!tracking) throw logic_error("connected: call trackConnectivity() first");
+        return findRoot(u) == findRoot(v);
+    }
+
+    // Whether addEdge(u, v) would close a cycle: u and v are already
+    // connected. As in hasCycleUndirected(), a self-loop and a repeat of an
+    // existing edge count as cycles.
+    bool wouldCreateCycle(int u, int v) const {
+        if (directed) throw logic_error("wouldCreateCycle: undirected graphs only");
+        return connected(u, v);
+    }
+
+    // Pack the adjacency lists into CSR arrays and release the lists
+    void freeze() {
+        if (frozen) return;
+        offsets.assign(vertices + 1, 0);
+        for (int u = 0; u < vertices; u++) offsets[u + 1] = offsets[u] + (int)adj[u].size();
+        targets.resize(offsets[vertices]);
+        weights.resize(offsets[vertices]);
+        for (int u = 0; u < vertices; u++) {
+            int e = offsets[u];
+            for (auto [v, w] : adj[u]) { targets[e] = v; weights[e] = w; e++; }
+        }
+        vector<vector<pair<int,int>>>().swap(adj);
+        if (directed) buildReverse();
+        frozen = true;
+    }
+
+    bool isFrozen() const { return frozen; }
+
+    // Build a frozen graph straight from an edge-list file (binary when it
+    // starts with the EdgeListHeader magic, text otherwise). The file is
+    // mmapped and split into chunks that threads parse independently; a
+    // first pass counts degrees with atomic increments, the prefix sum gives
+    // the CSR offsets, and a second pass drops each edge into its slot via a
+    // per-vertex atomic cursor, so nothing is reallocated per edge. Text
+    // files take one extra pass for the vertex count (max id + 1). With more
+    // than one thread a vertex's neighbours can come out in a different
+    // order than the file's, which changes BFS/DFS order but no distances.
+    // Parsed chunks are released from the resident set as each pass moves
+    // on, so peak memory is about the CSR arrays, not CSR plus the file.
+    static Graph loadEdgeList(const string& path, bool directed = false, int threads = 1) {
+        MappedFile file(path);
+        const char* data = file.begin();
+        const size_t size = file.size();
+        WorkerPool pool(max(1, threads));
+        threads = pool.size();
+        EdgeListHeader header{};
+        bool binary = size >= sizeof header && memcmp(data, "EDGELST", 8) == 0;
+        if (binary) {
+            memcpy(&header, data, sizeof header);
+            size_t record = (header.weighted ? 3 : 2) * sizeof(int32_t);
+            if (header.version != 1 || header.vertexCount > (uint64_t)numeric_limits<int>::max() ||
+                (size - sizeof header) / record < header.edgeCount)
+                throw runtime_error("loadEdgeList: bad header in " + path);
+        }
+
+        // Binary chunks are runs of records; text chunks are byte ranges,
+        // and a line belongs to the chunk holding its first byte
+        const size_t chunkBytes = 1 << 20, chunkRecords = 1 << 17;
+        size_t chunks = binary ? (header.edgeCount + chunkRecords - 1) / chunkRecords
+                               : (size + chunkBytes - 1) / chunkBytes;
+        atomic<bool> malformed(false);
+        auto parse = [&](auto&& onEdge) {
+            forBlocks(pool, chunks, 1, [&](int t, size_t lo, size_t hi) {
+                for (size_t c = lo; c < hi; c++) {
+                    if (binary) {
+                        const char* rec = data + sizeof header;
+                        size_t stride = header.weighted ? 3 : 2;
+                        size_t end = min<size_t>(header.edgeCount, (c + 1) * chunkRecords);
+                        for (size_t e = c * chunkRecords; e < end; e++) {
+                            int32_t f[3] = {0, 0, 1};
+                            memcpy(f, rec + e * stride * sizeof(int32_t), stride * sizeof(int32_t));
+                            if (f[0] < 0 || f[1] < 0 || (uint64_t)max(f[0], f[1]) >= header.vertexCount)
+                                malformed = true;
+                            else onEdge(t, f[0], f[1], f[2]);
+                        }
+                        file.release(sizeof header + c * chunkRecords * stride * sizeof(int32_t),
+                                     sizeof header + end * stride * sizeof(int32_t));
+                        continue;
+                    }
+                    const char* p   = data + c * chunkBytes;
+                    const char* end = data + min(size, (c + 1) * chunkBytes);
+                    const char* eof = data + size;
+                    if (p > data && p[-1] != '\n') {
+                        while (p < eof && *p != '\n') p++;
+                        if (p < eof) p++;
+                    }
+                    while (p < end) {
+                        long long f[3] = {0, 0, 1};
+                        int fields = 0;
+                        if (*p != '#' && *p != '%') {
+                            while (p < eof && *p != '\n') {
+                                if (*p == ' ' || *p == '\t' || *p == '\r' || *p == ',') { p++; continue; }
+                                bool neg = *p == '-';
+                                if (neg) p++;
+                                if (p >= eof || *p < '0' || *p > '9' || fields == 3) { malformed = true; break; }
+                                long long x = 0;
+                                while (p < eof && *p >= '0' && *p <= '9' && x <= numeric_limits<int>::max())
+                                    x = x * 10 + (*p++ - '0');
+                                f[fields++] = neg ? -x : x;
+                            }
+                            if (fields == 1 || f[0] < 0 || f[1] < 0 || max(f[0], f[1]) >= numeric_limits<int>::max() ||
+                                f[2] < numeric_limits<int>::min() || f[2] > numeric_limits<int>::max())
+                                malformed = true;
+                            else if (fields >= 2) onEdge(t, (int)f[0], (int)f[1], (int)f[2]);
+                        }
+                        while (p < eof && *p != '\n') p++;
+                        if (p < eof) p++;
+                    }
+                    file.release(c * chunkBytes, (c + 1) * chunkBytes);
+                }
+            });
+            if (malformed) throw runtime_error("loadEdgeList: malformed edge in " + path);
+        };
+
+        int n = (int)header.vertexCount;
+        if (!binary) {
+            vector<int> maxId(threads, -1);
+            parse([&](int t, int u, int v, int) { maxId[t] = max(maxId[t], max(u, v)); });
+            n = *max_element(maxId.begin(), maxId.end()) + 1;
+        }
+
+        Graph g(n, directed);
+        vector<vector<pair<int,int>>>().swap(g.adj);
+        unique_ptr<atomic<int>[]> cursor(new atomic<int>[n]);
+        for (int v = 0; v < n; v++) cursor[v].store(0, memory_order_relaxed);
+        parse([&](int, int u, int v, int) {
+            cursor[u].fetch_add(1, memory_order_relaxed);
+            if (!directed) cursor[v].fetch_add(1, memory_order_relaxed);
+        });
+        g.offsets.assign(n + 1, 0);
+        for (int v = 0; v < n; v++) {
+            long long next = (long long)g.offsets[v] + cursor[v].load(memory_order_relaxed);
+            if (next > numeric_limits<int>::max()) throw runtime_error("loadEdgeList: too many edges for int offsets");
+            g.offsets[v + 1] = (int)next;
+            cursor[v].store(g.offsets[v], memory_order_relaxed);
+        }
+        g.targets.resize(g.offsets[n]);
+        g.weights.resize(g.offsets[n]);
+        // Claim the slots of a whole batch before storing into them: each
+        // locked fetch_add waits for the store buffer to drain, so putting
+        // one between every pair of scattered stores stalls on each miss
+        struct alignas(64) EdgeBatch { int size = 0; array<int, 3> edges[256]; };
+        vector<EdgeBatch> pending(threads);
+        auto flush = [&](EdgeBatch& b) {
+            int slots[2 * 256];
+            int k = 0;
+            for (int i = 0; i < b.size; i++) {
+                slots[k++] = cursor[b.edges[i][0]].fetch_add(1, memory_order_relaxed);
+                if (!directed) slots[k++] = cursor[b.edges[i][1]].fetch_add(1, memory_order_relaxed);
+            }
+            k = 0;
+            for (int i = 0; i < b.size; i++) {
+                auto [u, v, w] = b.edges[i];
+                int e = slots[k++];
+                g.targets[e] = v; g.weights[e] = w;
+                if (!directed) { e = slots[k++]; g.targets[e] = u; g.weights[e] = w; }
+            }
+            b.size = 0;
+        };
+        parse([&](int t, int u, int v, int w) {
+            EdgeBatch& b = pending[t];
+            b.edges[b.size++] = {u, v, w};
+            if (b.size == 256) flush(b);
+        });
+        for (auto& b : pending) flush(b);
+        if (directed) g.buildReverse();
+        g.frozen = true;
+        return g;
     }
 
     // BFS - returns traversal order from src
+    // (the output vector doubles as the FIFO queue)
     vector<int> bfs(int src) const {
-        vector<bool> visited(vertices, false);
+        vector<char> visited(vertices, 0);
         vector<int>  order;
-        queue<int>   q;
-        visited[src] = true;
-        q.push(src);
-        while (!q.empty()) {
-            int node = q.front(); q.pop();
-            order.push_back(node);
-            for (auto [nb, _] : adj[node]) {
+        visited[src] = 1;
+        order.push_back(src);
+        for (size_t head = 0; head < order.size(); head++) {
+            scanNeighbors(order[head], [&](int nb, int) {
                 if (!visited[nb]) {
-                    visited[nb] = true;
-                    q.push(nb);
+                    visited[nb] = 1;
+                    order.push_back(nb);
                 }
-            }
+            });
         }
         return order;
     }
@@ -49,38 +590,142 @@ public:
     // BFS - shortest path distances from src (-1 = unreachable)
     vector<int> bfsDistances(int src) const {
         vector<int> dist(vertices, -1);
-        queue<int>  q;
+        vector<int> q;
+        q.reserve(vertices);
         dist[src] = 0;
-        q.push(src);
-        while (!q.empty()) {
-            int node = q.front(); q.pop();
-            for (auto [nb, _] : adj[node]) {
+        q.push_back(src);
+        for (size_t head = 0; head < q.size(); head++) {
+            int node = q[head];
+            scanNeighbors(node, [&](int nb, int) {
                 if (dist[nb] == -1) {
                     dist[nb] = dist[node] + 1;
-                    q.push(nb);
+                    q.push_back(nb);
                 }
-            }
+            });
         }
         return dist;
     }
 
+    // Parallel level-synchronous BFS with Beamer's direction optimization.
+    // Small frontiers expand top-down: threads split the frontier queue and
+    // claim unvisited neighbours with a CAS. Once the frontier's edges
+    // outnumber the unexplored ones / alpha it switches to bottom-up: each
+    // unvisited vertex scans its in-edges for any parent in the frontier
+    // bitmap and stops at the first, which skips most edges of big levels.
+    // It returns to top-down when the frontier shrinks below n / beta.
+    // Distances match bfsDistances(); a graph that is not frozen uses it.
+    vector<int> bfsDistancesParallel(int src, int threads) const {
+        if (!frozen) return bfsDistances(src);
+        const long long alpha = 14, beta = 24;
+        const int n = vertices;
+        WorkerPool pool(max(1, threads));
+        threads = pool.size();
+        const int* inOff = directed ? inOffsets.data() : offsets.data();
+        const int* inSrc = directed ? inSources.data() : targets.data();
+
+        unique_ptr<atomic<int>[]> dist(new atomic<int>[n]);
+        forBlocks(pool, n, 1 << 16, [&](int, size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; v++) dist[v].store(-1, memory_order_relaxed);
+        });
+        dist[src].store(0, memory_order_relaxed);
+
+        size_t words = ((size_t)n + 63) / 64;
+        vector<uint64_t> front(words), next(words);
+        vector<int> queue = {src};
+        vector<vector<int>> localNext(threads);
+        vector<long long> localEdges(threads), localCount(threads);
+
+        bool bottomUp = false;
+        long long frontierSize = 1;
+        long long frontierEdges = degree(src);                  // m_f
+        long long unexploredEdges = offsets[n] - frontierEdges; // m_u
+        for (int level = 0; frontierSize > 0; level++) {
+            if (!bottomUp && frontierEdges > unexploredEdges / alpha) {
+                fill(front.begin(), front.end(), 0);
+                for (int v : queue) front[v >> 6] |= 1ULL << (v & 63);
+                bottomUp = true;
+            } else if (bottomUp && frontierSize < n / beta) {
+                queue.clear();
+                for (size_t w = 0; w < words; w++)
+                    for (uint64_t bits = front[w]; bits; bits &= bits - 1)
+                        queue.push_back((int)(w * 64 + __builtin_ctzll(bits)));
+                bottomUp = false;
+            }
+            fill(localEdges.begin(), localEdges.end(), 0);
+            fill(localCount.begin(), localCount.end(), 0);
+
+            if (bottomUp) {
+                // Blocks of whole bitmap words: each next[] word has one writer
+                forBlocks(pool, words, 64, [&](int t, size_t lo, size_t hi) {
+                    for (size_t w = lo; w < hi; w++) {
+                        uint64_t found = 0;
+                        int end = (int)min<size_t>(n, w * 64 + 64);
+                        for (int v = (int)(w * 64); v < end; v++) {
+                            if (dist[v].load(memory_order_relaxed) != -1) continue;
+                            for (int e = inOff[v]; e < inOff[v + 1]; e++) {
+                                int u = inSrc[e];
+                                if (front[u >> 6] >> (u & 63) & 1) {
+                                    dist[v].store(level + 1, memory_order_relaxed);
+                                    found |= 1ULL << (v & 63);
+                                    localEdges[t] += offsets[v + 1] - offsets[v];
+                                    localCount[t]++;
+                                    break;
+                                }
+                            }
+                        }
+                        next[w] = found;
+                    }
+                });
+                front.swap(next);
+            } else {
+                forBlocks(pool, queue.size(), 256, [&](int t, size_t lo, size_t hi) {
+                    for (size_t i = lo; i < hi; i++) {
+                        int u = queue[i];
+                        for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                            int v = targets[e];
+                            int unseen = -1;
+                            if (dist[v].load(memory_order_relaxed) == -1 &&
+                                dist[v].compare_exchange_strong(unseen, level + 1, memory_order_relaxed)) {
+                                localNext[t].push_back(v);
+                                localEdges[t] += offsets[v + 1] - offsets[v];
+                            }
+                        }
+                    }
+                });
+                queue.clear();
+                for (auto& part : localNext) {
+                    queue.insert(queue.end(), part.begin(), part.end());
+                    localCount[0] += part.size();
+                    part.clear();
+                }
+            }
+            frontierSize  = accumulate(localCount.begin(), localCount.end(), 0LL);
+            frontierEdges = accumulate(localEdges.begin(), localEdges.end(), 0LL);
+            unexploredEdges -= frontierEdges;
+        }
+
+        vector<int> out(n);
+        for (int v = 0; v < n; v++) out[v] = dist[v].load(memory_order_relaxed);
+        return out;
+    }
+
     // BFS - shortest path from src to dst (returns path nodes)
     vector<int> bfsPath(int src, int dst) const {
         vector<int> parent(vertices, -1);
-        vector<bool> visited(vertices, false);
-        queue<int> q;
-        visited[src] = true;
-        q.push(src);
-        while (!q.empty()) {
-            int node = q.front(); q.pop();
+        vector<char> visited(vertices, 0);
+        vector<int> q;
+        visited[src] = 1;
+        q.push_back(src);
+        for (size_t head = 0; head < q.size(); head++) {
+            int node = q[head];
             if (node == dst) break;
-            for (auto [nb, _] : adj[node]) {
+            scanNeighbors(node, [&](int nb, int) {
                 if (!visited[nb]) {
-                    visited[nb]  = true;
+                    visited[nb]  = 1;
                     parent[nb]   = node;
-                    q.push(nb);
+                    q.push_back(nb);
                 }
-            }
+            });
         }
         if (parent[dst] == -1 && src != dst) return {};
         vector<int> path;
@@ -89,17 +734,187 @@ public:
         return path;
     }
 
+    // Dijkstra with an indexed heap: each vertex is in the heap at most once
+    // and an improvement is a decreaseKey, so the heap stays at <= n entries.
+    // Weights must be non-negative.
+    ShortestPaths dijkstra(int src) const {
+        const long long INF = ShortestPaths::kUnreachable;
+        ShortestPaths sp{vector<long long>(vertices, INF), vector<int>(vertices, -1)};
+        vector<char> settled(vertices, 0);
+        IndexedMinHeap heap(vertices);
+        sp.dist[src] = 0;
+        heap.push(src, 0);
+        while (!heap.empty()) {
+            int u = heap.popMin();
+            settled[u] = 1;
+            long long du = sp.dist[u];
+            scanNeighbors(u, [&](int v, int w) {
+                if (w < 0) throw invalid_argument("dijkstra: negative edge weight");
+                if (settled[v] || du + w >= sp.dist[v]) return;
+                bool queued = sp.dist[v] != INF;
+                sp.dist[v]   = du + w;
+                sp.parent[v] = u;
+                if (queued) heap.decreaseKey(v, du + w);
+                else        heap.push(v, du + w);
+            });
+        }
+        return sp;
+    }
+
+    // Parallel delta-stepping (Meyer & Sanders). Vertices sit in buckets of
+    // width delta by tentative distance; the lowest non-empty bucket is
+    // drained in rounds that relax its light edges (w <= delta) in parallel,
+    // since those can refill the same bucket, and its heavy edges once at the
+    // end, since those only reach later buckets. Relaxations are CAS-min on
+    // atomic distances. Parents are not tracked during the race; a final
+    // parallel pass picks, for each vertex, a predecessor on a tight edge
+    // (dist[u] + w == dist[v]). delta <= 0 picks the mean edge weight.
+    // Weights must be non-negative; distances match dijkstra().
+    ShortestPaths deltaStepping(int src, long long delta = 0, int threads = 1) const {
+        const long long INF = ShortestPaths::kUnreachable;
+        const int n = vertices;
+        threads = max(1, threads);
+        long long weightSum = 0;
+        bool zeroWeights = false;
+        for (int u = 0; u < n; u++)
+            scanNeighbors(u, [&](int, int w) {
+                if (w < 0) throw invalid_argument("deltaStepping: negative edge weight");
+                weightSum += w;
+                zeroWeights |= w == 0;
+            });
+        if (delta <= 0) delta = max(1LL, weightSum / max(1LL, numEdges()));
+        WorkerPool pool(threads);
+
+        unique_ptr<atomic<long long>[]> dist(new atomic<long long>[n]);
+        for (int v = 0; v < n; v++) dist[v].store(INF, memory_order_relaxed);
+        dist[src].store(0, memory_order_relaxed);
+
+        vector<vector<int>> buckets(1, vector<int>{src});
+        vector<long long> queuedIn(n, -1);    // bucket v is queued in, -1 = none
+        queuedIn[src] = 0;
+        vector<vector<int>> improved(threads);
+
+        auto relax = [&](const vector<int>& from, bool light) {
+            forBlocks(pool, from.size(), 256, [&](int t, size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; i++) {
+                    int u = from[i];
+                    long long du = dist[u].load(memory_order_relaxed);
+                    scanNeighbors(u, [&](int v, int w) {
+                        if ((w <= delta) != light) return;
+                        long long nd = du + w, cur = dist[v].load(memory_order_relaxed);
+                        while (nd < cur)
+                            if (dist[v].compare_exchange_weak(cur, nd, memory_order_relaxed)) {
+                                improved[t].push_back(v);
+                                break;
+                            }
+                    });
+                }
+            });
+            for (auto& part : improved) {
+                for (int v : part) {
+                    long long b = dist[v].load(memory_order_relaxed) / delta;
+                    if (queuedIn[v] == b) continue;
+                    if ((size_t)b >= buckets.size()) buckets.resize(b + 1);
+                    buckets[b].push_back(v);
+                    queuedIn[v] = b;
+                }
+                part.clear();
+            }
+        };
+
+        vector<int> frontier, drained;
+        for (size_t b = 0; b < buckets.size(); b++) {
+            drained.clear();
+            while (!buckets[b].empty()) {
+                frontier.swap(buckets[b]);
+                buckets[b].clear();
+                // Skip entries that moved to a lower bucket after being queued
+                size_t keep = 0;
+                for (int v : frontier) {
+                    if (dist[v].load(memory_order_relaxed) / delta != (long long)b) continue;
+                    queuedIn[v] = -1;
+                    frontier[keep++] = v;
+                }
+                frontier.resize(keep);
+                relax(frontier, true);
+                drained.insert(drained.end(), frontier.begin(), frontier.end());
+            }
+            sort(drained.begin(), drained.end());
+            drained.erase(unique(drained.begin(), drained.end()), drained.end());
+            relax(drained, false);
+        }
+
+        ShortestPaths sp{vector<long long>(n), vector<int>(n, -1)};
+        for (int v = 0; v < n; v++) sp.dist[v] = dist[v].load(memory_order_relaxed);
+        // Positive tight edges only point forward in distance, so any choice
+        // among them is acyclic; the first CAS to claim v wins.
+        unique_ptr<atomic<int>[]> parent(new atomic<int>[n]);
+        for (int v = 0; v < n; v++) parent[v].store(-1, memory_order_relaxed);
+        forBlocks(pool, n, 1 << 12, [&](int, size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; u++) {
+                if (sp.dist[u] == INF) continue;
+                scanNeighbors((int)u, [&](int v, int w) {
+                    int none = -1;
+                    if (w > 0 && sp.dist[u] + w == sp.dist[v] && parent[v].load(memory_order_relaxed) == -1)
+                        parent[v].compare_exchange_strong(none, (int)u, memory_order_relaxed);
+                });
+            }
+        });
+        for (int v = 0; v < n; v++) sp.parent[v] = parent[v].load(memory_order_relaxed);
+        // Vertices reached only through zero-weight edges: grow the tree
+        // along tight zero edges from the vertices that already have a parent
+        if (zeroWeights) {
+            vector<int> q;
+            for (int v = 0; v < n; v++)
+                if (v == src || sp.parent[v] != -1) q.push_back(v);
+            for (size_t head = 0; head < q.size(); head++) {
+                int u = q[head];
+                scanNeighbors(u, [&](int v, int w) {
+                    if (w == 0 && v != src && sp.parent[v] == -1 && sp.dist[v] == sp.dist[u]) {
+                        sp.parent[v] = u;
+                        q.push_back(v);
+                    }
+                });
+            }
+        }
+        return sp;
+    }
+
+    // Bellman-Ford: n-1 rounds relaxing every edge, stopping early once a
+    // round changes nothing. Handles negative weights; throws on a negative
+    // cycle reachable from src. O(V*E) worst case.
+    ShortestPaths bellmanFord(int src) const {
+        const long long INF = ShortestPaths::kUnreachable;
+        ShortestPaths sp{vector<long long>(vertices, INF), vector<int>(vertices, -1)};
+        sp.dist[src] = 0;
+        for (int round = 0; round < vertices; round++) {
+            bool changed = false;
+            for (int u = 0; u < vertices; u++) {
+                if (sp.dist[u] == INF) continue;
+                scanNeighbors(u, [&](int v, int w) {
+                    if (sp.dist[u] + w < sp.dist[v]) {
+                        sp.dist[v]   = sp.dist[u] + w;
+                        sp.parent[v] = u;
+                        changed = true;
+                    }
+                });
+            }
+            if (!changed) return sp;
+        }
+        throw runtime_error("bellmanFord: negative-weight cycle reachable from source");
+    }
+
     // DFS - recursive
-    void dfsHelper(int node, vector<bool>& visited, vector<int>& order) const {
-        visited[node] = true;
+    void dfsHelper(int node, vector<char>& visited, vector<int>& order) const {
+        visited[node] = 1;
         order.push_back(node);
-        for (auto [nb, _] : adj[node]) {
+        scanNeighbors(node, [&](int nb, int) {
             if (!visited[nb]) dfsHelper(nb, visited, order);
-        }
+        });
     }
 
     vector<int> dfs(int src) const {
-        vector<bool> visited(vertices, false);
+        vector<char> visited(vertices, 0);
         vector<int>  order;
         dfsHelper(src, visited, order);
         return order;
@@ -107,50 +922,132 @@ public:
 
     // DFS - iterative (using explicit stack)
     vector<int> dfsIterative(int src) const {
-        vector<bool> visited(vertices, false);
+        vector<char> visited(vertices, 0);
         vector<int>  order;
-        stack<int>   st;
-        st.push(src);
+        vector<int>  st;
+        st.push_back(src);
         while (!st.empty()) {
-            int node = st.top(); st.pop();
+            int node = st.back(); st.pop_back();
             if (visited[node]) continue;
-            visited[node] = true;
+            visited[node] = 1;
             order.push_back(node);
-            for (auto it = adj[node].rbegin(); it != adj[node].rend(); ++it)
-                if (!visited[it->first]) st.push(it->first);
+            // Push in reverse so neighbours pop in insertion order
+            size_t mark = st.size();
+            scanNeighbors(node, [&](int nb, int) { if (!visited[nb]) st.push_back(nb); });
+            reverse(st.begin() + mark, st.end());
         }
         return order;
     }
 
+    // Connected components with a lock-free union-find (Afforest, Sutton et
+    // al.), the weakly connected ones for a directed graph. Roots are linked
+    // by CAS, always the higher id under the lower, so each tree's root is
+    // its smallest vertex. Each vertex first links along its first two edges
+    // only, then a sample of 1024 vertices finds the giant component, and
+    // the remaining edges are scanned only for vertices outside it: the edges
+    // inside the giant component, most of the graph, are never touched.
+    // That shortcut needs every edge stored in both directions, so directed
+    // graphs scan all remaining edges.
+    Components componentLabels(int threads) const {
+        const int n = vertices, neighborRounds = 2;
+        WorkerPool pool(max(1, threads));
+        unique_ptr<atomic<int>[]> comp(new atomic<int>[n]);
+        auto find = [&](int v) { return comp[v].load(memory_order_relaxed); };
+        auto link = [&](int u, int v) {
+            int p1 = find(u), p2 = find(v);
+            while (p1 != p2) {
+                int high = max(p1, p2), low = min(p1, p2);
+                int pHigh = find(high);
+                if (pHigh == low) break;
+                if (pHigh == high && comp[high].compare_exchange_strong(pHigh, low, memory_order_relaxed))
+                    break;
+                p1 = find(find(high));
+                p2 = find(low);
+            }
+        };
+        auto compress = [&] {
+            forBlocks(pool, n, 1 << 14, [&](int, size_t lo, size_t hi) {
+                for (size_t v = lo; v < hi; v++)
+                    while (find(v) != find(find(v))) comp[v].store(find(find(v)), memory_order_relaxed);
+            });
+        };
+        auto neighborAt = [&](int u, int i) { return frozen ? targets[offsets[u] + i] : adj[u][i].first; };
+
+        forBlocks(pool, n, 1 << 14, [&](int, size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; v++) comp[v].store((int)v, memory_order_relaxed);
+        });
+        for (int r = 0; r < neighborRounds; r++) {
+            forBlocks(pool, n, 1 << 12, [&](int, size_t lo, size_t hi) {
+                for (size_t u = lo; u < hi; u++)
+                    if (degree((int)u) > r) link((int)u, neighborAt((int)u, r));
+            });
+            compress();
+        }
+
+        // Most frequent root among the samples; -1 disables the skip
+        int giant = -1;
+        if (!directed && n > 0) {
+            unordered_map<int, int> seen;
+            mt19937 rng(27491095);
+            uniform_int_distribution<int> pick(0, n - 1);
+            int bestCount = 0;
+            for (int i = 0; i < 1024; i++) {
+                int c = find(pick(rng));
+                if (++seen[c] > bestCount) { bestCount = seen[c]; giant = c; }
+            }
+        }
+        forBlocks(pool, n, 1 << 10, [&](int, size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; u++) {
+                if (find((int)u) == giant) continue;
+                for (int i = neighborRounds; i < degree((int)u); i++) link((int)u, neighborAt((int)u, i));
+            }
+        });
+        compress();
+
+        Components result{vector<int>(n), {}};
+        for (int v = 0; v < n; v++) {
+            int root = find(v);
+            if (root == v) { result.label[v] = result.count(); result.sizes.push_back(0); }
+            else result.label[v] = result.label[root];
+            result.sizes[result.label[v]]++;
+        }
+        return result;
+    }
+
     // Connected components (for undirected graphs)
     int countComponents() const {
-        vector<bool> visited(vertices, false);
+        if (tracking && !directed) return trackedComponents;
+        vector<char> visited(vertices, 0);
+        vector<int>  q;
+        q.reserve(vertices);
         int count = 0;
         for (int i = 0; i < vertices; i++) {
             if (!visited[i]) {
                 count++;
                 // mini BFS
-                queue<int> q; q.push(i); visited[i] = true;
-                while (!q.empty()) {
-                    int node = q.front(); q.pop();
-                    for (auto [nb, _] : adj[node])
-                        if (!visited[nb]) { visited[nb] = true; q.push(nb); }
-                }
+                q.clear(); q.push_back(i); visited[i] = 1;
+                for (size_t head = 0; head < q.size(); head++)
+                    scanNeighbors(q[head], [&](int nb, int) {
+                        if (!visited[nb]) { visited[nb] = 1; q.push_back(nb); }
+                    });
             }
         }
         return count;
     }
 
-    // Cycle detection (undirected)
+    // Cycle detection (undirected). Every edge beyond a spanning forest
+    // closes a cycle, so a self-loop or an edge added twice counts; the DFS
+    // skips only the one tree edge back to the parent, not every edge to it.
     bool hasCycleUndirected() const {
-        vector<bool> visited(vertices, false);
+        if (tracking && !directed) return cycleSeen;
+        vector<char> visited(vertices, 0);
         function<bool(int,int)> dfsCycle = [&](int node, int parent) -> bool {
-            visited[node] = true;
-            for (auto [nb, _] : adj[node]) {
-                if (!visited[nb]) { if (dfsCycle(nb, node)) return true; }
-                else if (nb != parent)  return true;
-            }
-            return false;
+            visited[node] = 1;
+            bool skippedParent = false;
+            return scanNeighbors(node, [&](int nb, int) {
+                if (nb == parent && !skippedParent) { skippedParent = true; return false; }
+                return visited[nb] ? true : dfsCycle(nb, node);
+            });
         };
         for (int i = 0; i < vertices; i++)
             if (!visited[i] && dfsCycle(i, -1)) return true;
@@ -162,15 +1059,16 @@ public:
         if (!directed) { cout << "Topological sort requires directed graph.\n"; return {}; }
         vector<int> inDegree(vertices, 0);
         for (int u = 0; u < vertices; u++)
-            for (auto [v, _] : adj[u]) inDegree[v]++;
+            scanNeighbors(u, [&](int v, int) { inDegree[v]++; });
         queue<int> q;
         for (int i = 0; i < vertices; i++) if (inDegree[i] == 0) q.push(i);
         vector<int> order;
         while (!q.empty()) {
             int node = q.front(); q.pop();
             order.push_back(node);
-            for (auto [nb, _] : adj[node])
+            scanNeighbors(node, [&](int nb, int) {
                 if (--inDegree[nb] == 0) q.push(nb);
+            });
         }
         if ((int)order.size() != vertices) {
             cout << "Cycle detected - no topological order.\n";
@@ -183,18 +1081,362 @@ public:
         cout << "Adjacency List (" << (directed ? "directed" : "undirected") << "):\n";
         for (int i = 0; i < vertices; i++) {
             cout << "  " << i << " -> [";
-            for (size_t j = 0; j < adj[i].size(); j++) {
-                cout << adj[i][j].first;
-                if (adj[i][j].second != 1) cout << "(" << adj[i][j].second << ")";
-                if (j + 1 < adj[i].size()) cout << ", ";
-            }
+            bool first = true;
+            scanNeighbors(i, [&](int v, int w) {
+                if (!first) cout << ", ";
+                cout << v;
+                if (w != 1) cout << "(" << w << ")";
+                first = false;
+            });
             cout << "]\n";
         }
     }
 
     int numVertices() const { return vertices; }
+
+    // Adjacency entries (an undirected edge counts twice)
+    long long numEdges() const {
+        if (frozen) return offsets[vertices];
+        long long m = 0;
+        for (const auto& list : adj) m += list.size();
+        return m;
+    }
+
+    vector<int> neighbors(int u) const {
+        vector<int> out;
+        out.reserve(degree(u));
+        scanNeighbors(u, [&](int v, int) { out.push_back(v); });
+        return out;
+    }
+
+    int degree(int u) const {
+        return frozen ? offsets[u + 1] - offsets[u] : (int)adj[u].size();
+    }
 };
 
+// -- Synthetic graphs -------------------------------------------------------
+// R-MAT (Chakrabarti et al.): each edge picks a quadrant of the adjacency
+// matrix recursively with probabilities a, b, c, d, giving the skewed,
+// power-law degrees of web and social graphs. 2^scale vertices.
+// forEachRMatEdge streams the edges (self-loops dropped) to fn(u, v, w).
+template<typename F>
+void forEachRMatEdge(int scale, int edgeFactor, unsigned seed, int maxWeight, F&& fn) {
+    const double a = 0.57, b = 0.19, c = 0.19;
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    uniform_int_distribution<int> weight(1, max(1, maxWeight));
+    long long edges = (long long)edgeFactor << scale;
+    for (long long e = 0; e < edges; e++) {
+        int u = 0, v = 0;
+        for (int bit = scale - 1; bit >= 0; bit--) {
+            double r = coin(rng);
+            if (r < a) {}
+            else if (r < a + b) v |= 1 << bit;
+            else if (r < a + b + c) u |= 1 << bit;
+            else { u |= 1 << bit; v |= 1 << bit; }
+        }
+        if (u != v) fn(u, v, weight(rng));
+    }
+}
+
+Graph makeRMat(int scale, int edgeFactor, unsigned seed = 1, bool directed = false,
+               int maxWeight = 1) {
+    Graph g(1 << scale, directed);
+    forEachRMatEdge(scale, edgeFactor, seed, maxWeight, [&](int u, int v, int w) { g.addEdge(u, v, w); });
+    return g;
+}
+
+// Road-network stand-in: a rows x cols grid with 4-neighbour streets and
+// random travel times in [1, maxWeight]. Low, uniform degree and a diameter
+// in the thousands of hops, unlike R-MAT's hubs and tiny diameter.
+Graph makeGrid(int rows, int cols, int maxWeight, unsigned seed = 1) {
+    Graph g(rows * cols, false);
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> weight(1, max(1, maxWeight));
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < cols; c++) {
+            int u = r * cols + c;
+            if (c + 1 < cols) g.addEdge(u, u + 1, weight(rng));
+            if (r + 1 < rows) g.addEdge(u, u + cols, weight(rng));
+        }
+    return g;
+}
+
+// -- Benchmarks -------------------------------------------------------------
+double timeMs(const function<void()>& fn) {
+    auto start = chrono::steady_clock::now();
+    fn();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Traversal throughput, adjacency lists vs CSR, on the same R-MAT graph
+void benchmarkCSR(int scale, int edgeFactor) {
+    Graph lists = makeRMat(scale, edgeFactor, 7);
+    Graph csr   = makeRMat(scale, edgeFactor, 7);
+    double freezeMs = timeMs([&] { csr.freeze(); });
+    long long m = csr.numEdges();
+    cout << "R-MAT scale " << scale << ": " << csr.numVertices() << " vertices, " << m
+         << " adjacency entries (freeze: " << fixed << setprecision(1) << freezeMs << " ms)\n";
+
+    // Start from the highest-degree vertex so BFS/DFS reach the giant component
+    int src = 0;
+    for (int u = 0; u < csr.numVertices(); u++) if (csr.degree(u) > csr.degree(src)) src = u;
+
+    cout << left << setw(18) << "traversal" << right << setw(16) << "lists Medges/s"
+         << setw(14) << "CSR Medges/s" << setw(10) << "speedup\n";
+    auto row = [&](const string& name, const function<long long(const Graph&)>& run) {
+        long long touched = 0;
+        double a = timeMs([&] { touched = run(lists); });
+        double b = timeMs([&] { run(csr); });
+        cout << left << setw(18) << name << right << setprecision(1)
+             << setw(16) << touched / a / 1e3 << setw(14) << touched / b / 1e3
+             << setw(8) << setprecision(2) << a / b << "x\n";
+    };
+    // Edges scanned = total degree of the vertices reached
+    auto reachedEdges = [](const Graph& g, const vector<int>& order) {
+        long long e = 0;
+        for (int u : order) e += g.degree(u);
+        return e;
+    };
+    row("bfs", [&](const Graph& g) { return reachedEdges(g, g.bfs(src)); });
+    row("bfsDistances", [&](const Graph& g) {
+        auto d = g.bfsDistances(src);
+        long long e = 0;
+        for (int u = 0; u < g.numVertices(); u++) if (d[u] >= 0) e += g.degree(u);
+        return e;
+    });
+    row("dfsIterative", [&](const Graph& g) { return reachedEdges(g, g.dfsIterative(src)); });
+    row("countComponents", [&](const Graph& g) { g.countComponents(); return g.numEdges(); });
+}
+
+// Traversed edges per second (sum of degrees of reached vertices), best of 3
+void benchmarkParallelBFS(int scale, int edgeFactor) {
+    for (bool directed : {false, true}) {
+        Graph g = makeRMat(scale, edgeFactor, 11, directed);
+        g.freeze();
+        int src = 0;
+        for (int u = 0; u < g.numVertices(); u++) if (g.degree(u) > g.degree(src)) src = u;
+
+        vector<int> expected;
+        double seqMs = 1e18;
+        for (int r = 0; r < 3; r++) seqMs = min(seqMs, timeMs([&] { expected = g.bfsDistances(src); }));
+        long long traversed = 0;
+        for (int u = 0; u < g.numVertices(); u++) if (expected[u] >= 0) traversed += g.degree(u);
+
+        cout << "R-MAT scale " << scale << (directed ? ", directed" : ", undirected") << ": "
+             << g.numEdges() << " edges, " << traversed << " reachable from the hub; hardware threads: "
+             << thread::hardware_concurrency() << "\n";
+        cout << fixed << setprecision(3);
+        cout << "  bfsDistances (queue)       : " << traversed / seqMs / 1e6 << " GTEPS\n";
+        for (int threads : {1, 2, 4, 8}) {
+            vector<int> got;
+            double ms = 1e18;
+            for (int r = 0; r < 3; r++) ms = min(ms, timeMs([&] { got = g.bfsDistancesParallel(src, threads); }));
+            cout << "  bfsDistancesParallel x" << threads << (threads < 10 ? " " : "") << "   : "
+                 << traversed / ms / 1e6 << " GTEPS" << (got == expected ? "" : "  MISMATCH") << "\n";
+        }
+    }
+}
+
+// Bellman-Ford vs Dijkstra vs delta-stepping on weighted grids, best of 3.
+// Bellman-Ford only runs on the smaller grid: its rounds grow with the
+// number of hops on the longest shortest path, so it is O(V*E) in practice.
+void benchmarkShortestPaths(int smallSide, int largeSide) {
+    cout << "hardware threads: " << thread::hardware_concurrency() << "\n";
+    for (int side : {smallSide, largeSide}) {
+        Graph g = makeGrid(side, side, 100, 5);
+        g.freeze();
+        int src = 0;
+        cout << "grid " << side << "x" << side << ": " << g.numVertices() << " vertices, "
+             << g.numEdges() << " adjacency entries\n" << fixed << setprecision(1);
+        auto best = [](const function<void()>& fn) {
+            double ms = 1e18;
+            for (int r = 0; r < 3; r++) ms = min(ms, timeMs(fn));
+            return ms;
+        };
+        // Every reached vertex but the source hangs off a strictly closer parent
+        auto treeOk = [&](const ShortestPaths& sp) {
+            for (int v = 0; v < g.numVertices(); v++) {
+                if (v == src || sp.dist[v] == ShortestPaths::kUnreachable) continue;
+                if (sp.parent[v] < 0 || sp.dist[sp.parent[v]] >= sp.dist[v]) return false;
+            }
+            return true;
+        };
+        ShortestPaths expected;
+        double dijkstraMs = best([&] { expected = g.dijkstra(src); });
+        if (side == smallSide) {
+            ShortestPaths bf;
+            double ms = best([&] { bf = g.bellmanFord(src); });
+            cout << "  bellmanFord         : " << setw(9) << ms << " ms"
+                 << (bf.dist == expected.dist && treeOk(bf) ? "" : "  MISMATCH") << "\n";
+        }
+        cout << "  dijkstra            : " << setw(9) << dijkstraMs << " ms"
+             << (treeOk(expected) ? "" : "  BAD TREE") << "\n";
+        for (int threads : {1, 2, 4, 8}) {
+            ShortestPaths got;
+            double ms = best([&] { got = g.deltaStepping(src, 0, threads); });
+            cout << "  deltaStepping x" << threads << "    : " << setw(9) << ms << " ms"
+                 << (got.dist == expected.dist && treeOk(got) ? "" : "  MISMATCH") << "\n";
+        }
+    }
+}
+
+// componentLabels vs BFS countComponents on R-MAT graphs, best of 3. Each
+// result is checked edge by edge: endpoints share a label, and the label
+// count equals the BFS component count, so the partitions are identical.
+void benchmarkComponents(int scale) {
+    cout << "hardware threads: " << thread::hardware_concurrency() << "\n";
+    for (int edgeFactor : {2, 16}) {
+        Graph g = makeRMat(scale, edgeFactor, 13);
+        g.freeze();
+        int expected = 0;
+        double bfsMs = 1e18;
+        for (int r = 0; r < 3; r++) bfsMs = min(bfsMs, timeMs([&] { expected = g.countComponents(); }));
+        cout << "R-MAT scale " << scale << ", edge factor " << edgeFactor << ": " << g.numEdges()
+             << " adjacency entries, " << expected << " components\n" << fixed << setprecision(1);
+        cout << "  countComponents (BFS)   : " << setw(8) << bfsMs << " ms\n";
+        for (int threads : {1, 2, 4, 8}) {
+            Components cc;
+            double ms = 1e18;
+            for (int r = 0; r < 3; r++) ms = min(ms, timeMs([&] { cc = g.componentLabels(threads); }));
+            bool ok = cc.count() == expected &&
+                      accumulate(cc.sizes.begin(), cc.sizes.end(), 0LL) == g.numVertices();
+            for (int u = 0; ok && u < g.numVertices(); u++)
+                for (int v : g.neighbors(u)) ok = ok && cc.label[u] == cc.label[v];
+            cout << "  componentLabels x" << threads << "      : " << setw(8) << ms << " ms  ("
+                 << setprecision(2) << bfsMs / ms << "x vs BFS)" << setprecision(1)
+                 << (ok ? "" : "  MISMATCH") << "\n";
+        }
+    }
+}
+
+// Resident set size and its high-water mark in KB (Linux /proc); 0 elsewhere.
+// resetPeakRSS() lowers the high-water mark to the current RSS.
+size_t procStatusKB(const string& field) {
+#ifdef __linux__
+    ifstream in("/proc/self/status");
+    for (string line; getline(in, line);)
+        if (line.compare(0, field.size(), field) == 0) return stoul(line.substr(field.size() + 1));
+#endif
+    (void)field;
+    return 0;
+}
+
+void resetPeakRSS() {
+#ifdef __linux__
+    ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+// Write an R-MAT edge list in the binary format, or as text
+void writeRMatEdgeList(const string& path, bool binary, int scale, int edgeFactor, unsigned seed) {
+    ofstream out(path, ios::binary);
+    if (!out) throw runtime_error("Cannot create " + path);
+    vector<int32_t> records;
+    forEachRMatEdge(scale, edgeFactor, seed, 1, [&](int u, int v, int) {
+        records.push_back(u); records.push_back(v);
+    });
+    if (binary) {
+        EdgeListHeader header{{'E', 'D', 'G', 'E', 'L', 'S', 'T', 0}, 1, 0,
+                              (uint64_t)1 << scale, records.size() / 2};
+        out.write(reinterpret_cast<const char*>(&header), sizeof header);
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(int32_t));
+    } else {
+        string text = "# R-MAT scale " + to_string(scale) + "\n";
+        for (size_t i = 0; i < records.size(); i += 2) {
+            text += to_string(records[i]); text += ' ';
+            text += to_string(records[i + 1]); text += '\n';
+            if (text.size() > (1 << 20)) { out << text; text.clear(); }
+        }
+        out << text;
+    }
+}
+
+// Load time and peak RSS: an ifstream + addEdge loop against loadEdgeList
+// on text and binary files of the same R-MAT graph. RSS includes the mapped
+// file pages the loader touches.
+void benchmarkEdgeListLoad(int scale, int edgeFactor) {
+    auto dir = filesystem::temp_directory_path();
+    string textPath = (dir / "graph_edges.txt").string(), binPath = (dir / "graph_edges.bin").string();
+    writeRMatEdgeList(textPath, false, scale, edgeFactor, 17);
+    writeRMatEdgeList(binPath, true, scale, edgeFactor, 17);
+    cout << "R-MAT scale " << scale << ", edge factor " << edgeFactor << ": text "
+         << filesystem::file_size(textPath) / (1 << 20) << " MB, binary "
+         << filesystem::file_size(binPath) / (1 << 20) << " MB; hardware threads: "
+         << thread::hardware_concurrency() << "\n" << fixed << setprecision(1);
+
+    vector<int> expected;
+    auto row = [&](const string& name, const function<Graph()>& load) {
+        size_t before = procStatusKB("VmRSS");
+        resetPeakRSS();
+        Graph g(0);
+        double ms = timeMs([&] { g = load(); });
+        double peakMB = ((double)procStatusKB("VmHWM") - before) / 1024;
+        // A text file only implies max id + 1 vertices; pad to compare
+        vector<int> degrees(max<size_t>(g.numVertices(), expected.size()));
+        for (int u = 0; u < g.numVertices(); u++) degrees[u] = g.degree(u);
+        if (expected.empty()) expected = degrees;
+        cout << "  " << left << setw(24) << name << right << setw(9) << ms << " ms" << setw(9)
+             << peakMB << " MB peak" << (degrees == expected ? "" : "  MISMATCH") << "\n";
+    };
+    row("ifstream + addEdge", [&] {
+        ifstream in(textPath);
+        in.ignore(numeric_limits<streamsize>::max(), '\n');
+        Graph g(1 << scale);
+        for (int u, v; in >> u >> v;) g.addEdge(u, v);
+        g.freeze();
+        return g;
+    });
+    for (int threads : {1, 4})
+        row("loadEdgeList text x" + to_string(threads), [&] { return Graph::loadEdgeList(textPath, false, threads); });
+    for (int threads : {1, 4})
+        row("loadEdgeList binary x" + to_string(threads), [&] { return Graph::loadEdgeList(binPath, false, threads); });
+    filesystem::remove(textPath);
+    filesystem::remove(binPath);
+}
+
+// An edge stream with a connectivity query after every edge, as a service
+// would see it: union-find tracking against recomputing with BFS. Random
+// edges on n vertices; the stream stops at 0.75 n edges, just past the
+// point where a giant component forms, so queries are not all "yes".
+void benchmarkIncrementalConnectivity(int n) {
+    const int edges = n / 4 * 3, samples = 20;
+    mt19937 rng(23);
+    vector<array<int, 4>> stream(edges);   // edge u-v, then query a-b
+    for (auto& op : stream) for (int& x : op) x = (int)(rng() % n);
+
+    Graph plain(n), tracked(n);
+    tracked.trackConnectivity();
+    double plainMs = timeMs([&] { for (auto& op : stream) plain.addEdge(op[0], op[1]); });
+    long long yes = 0, cycles = 0;
+    double trackedMs = timeMs([&] {
+        for (auto& op : stream) {
+            cycles += tracked.wouldCreateCycle(op[0], op[1]);
+            tracked.addEdge(op[0], op[1]);
+            yes += tracked.connected(op[2], op[3]);
+        }
+    });
+
+    // Recomputing: one BFS per "connected?" and per component count
+    bool ok = tracked.countComponents() == plain.countComponents();
+    double bfsMs = timeMs([&] {
+        for (int i = 0; i < samples; i++) {
+            auto& op = stream[edges - 1 - i];
+            ok = ok && tracked.connected(op[2], op[3]) == !plain.bfsPath(op[2], op[3]).empty();
+        }
+    }) / samples;
+    double countMs = timeMs([&] { plain.countComponents(); });
+
+    cout << n << " vertices, " << edges << " edges (" << cycles << " closed a cycle), "
+         << yes << " of " << edges << " queries connected\n" << fixed << setprecision(1);
+    cout << "  addEdge, untracked               : " << setw(10) << plainMs * 1e6 / edges << " ns/edge\n";
+    cout << "  addEdge + 2 queries, tracked     : " << setw(10) << trackedMs * 1e6 / edges << " ns/edge"
+         << (ok ? "" : "  MISMATCH") << "\n";
+    cout << "  connected() by BFS (bfsPath)     : " << setw(10) << bfsMs << " ms/query\n";
+    cout << "  countComponents() by BFS         : " << setw(10) << countMs << " ms/query\n";
+    cout << "  countComponents(), tracked       : O(1) counter\n";
+}
+
 void printVec(const vector<int>& v, const string& label) {
     cout << label << ": ";
     for (size_t i = 0; i < v.size(); i++) {
@@ -261,5 +1503,87 @@ int main() {
     disc.printAdjList();
     cout << "Connected components: " << disc.countComponents() << "\n";
 
+    // -- CSR (frozen) form: same answers from flat arrays --
+    cout << "\n-- CSR form of the undirected graph --\n";
+    g.freeze();
+    cout << "Frozen: " << (g.isFrozen() ? "yes" : "no") << ", " << g.numEdges() << " adjacency entries\n";
+    printVec(g.bfs(0), "BFS order");
+    printVec(g.dfsIterative(0), "DFS iterative");
+    printVec(g.bfsPath(0, 6), "Path 0 -> 6");
+    cout << "Components: " << g.countComponents() << ", has cycle: "
+         << (g.hasCycleUndirected() ? "Yes" : "No") << "\n";
+
+    cout << "\n-- Benchmark: adjacency lists vs CSR --\n";
+    benchmarkCSR(19, 16);
+
+    cout << "\n-- Parallel direction-optimizing BFS --\n";
+    auto seqDist = g.bfsDistances(0);
+    cout << "Undirected, 4 threads matches bfsDistances: "
+         << (g.bfsDistancesParallel(0, 4) == seqDist ? "yes" : "no") << "\n";
+    dag.freeze();
+    cout << "DAG from 5, 4 threads matches bfsDistances: "
+         << (dag.bfsDistancesParallel(5, 4) == dag.bfsDistances(5) ? "yes" : "no") << "\n";
+
+    cout << "\n-- Benchmark: parallel BFS (GTEPS vs threads) --\n";
+    benchmarkParallelBFS(20, 16);
+
+    cout << "\n-- Weighted shortest paths --\n";
+    Graph roads(6, false);
+    roads.addEdge(0, 1, 7); roads.addEdge(0, 2, 9); roads.addEdge(0, 5, 14);
+    roads.addEdge(1, 2, 10); roads.addEdge(1, 3, 15); roads.addEdge(2, 3, 11);
+    roads.addEdge(2, 5, 2);  roads.addEdge(3, 4, 6);  roads.addEdge(4, 5, 9);
+    auto sp = roads.dijkstra(0);
+    for (int i = 0; i < roads.numVertices(); i++)
+        cout << "  dist(0 -> " << i << ") = " << sp.dist[i] << "\n";
+    printVec(sp.pathTo(4), "Path 0 -> 4");
+    roads.freeze();
+    cout << "deltaStepping (4 threads) matches: "
+         << (roads.deltaStepping(0, 5, 4).dist == sp.dist ? "yes" : "no")
+         << ", bellmanFord matches: " << (roads.bellmanFord(0).dist == sp.dist ? "yes" : "no") << "\n";
+
+    cout << "\n-- Benchmark: shortest paths on road-like grids --\n";
+    benchmarkShortestPaths(256, 1000);
+
+    cout << "\n-- Parallel connected components (union-find) --\n";
+    auto cc = disc.componentLabels(4);
+    cout << "Disconnected graph: " << cc.count() << " components, labels:";
+    for (int l : cc.label) cout << " " << l;
+    cout << ", sizes:";
+    for (int sz : cc.sizes) cout << " " << sz;
+    cout << "\n";
+
+    cout << "\n-- Benchmark: componentLabels vs BFS --\n";
+    benchmarkComponents(20);
+
+    cout << "\n-- Edge-list loader --\n";
+    string edgePath = (filesystem::temp_directory_path() / "graph_demo_edges.txt").string();
+    ofstream(edgePath) << "# u v w\n0 1 7\n0 2 9\n0 5 14\n1 2 10\n1 3 15\n2 3 11\n2 5 2\n3 4 6\n4 5 9\n";
+    Graph loaded = Graph::loadEdgeList(edgePath, false, 2);
+    filesystem::remove(edgePath);
+    cout << "Loaded " << loaded.numVertices() << " vertices, " << loaded.numEdges()
+         << " adjacency entries; dijkstra matches: " << (loaded.dijkstra(0).dist == sp.dist ? "yes" : "no") << "\n";
+
+    cout << "\n-- Benchmark: edge-list loading --\n";
+    benchmarkEdgeListLoad(19, 16);
+
+    cout << "\n-- Incremental connectivity --\n";
+    Graph live(6, false);
+    live.trackConnectivity();
+    live.addEdge(0, 1); live.addEdge(1, 2); live.addEdge(3, 4);
+    cout << "connected(0, 2): " << (live.connected(0, 2) ? "yes" : "no")
+         << ", connected(2, 3): " << (live.connected(2, 3) ? "yes" : "no")
+         << ", components: " << live.countComponents() << "\n";
+    cout << "wouldCreateCycle(0, 2): " << (live.wouldCreateCycle(0, 2) ? "yes" : "no")
+         << ", wouldCreateCycle(2, 3): " << (live.wouldCreateCycle(2, 3) ? "yes" : "no") << "\n";
+    live.addEdge(2, 3);
+    cout << "after addEdge(2, 3): connected(0, 4): " << (live.connected(0, 4) ? "yes" : "no")
+         << ", components: " << live.countComponents() << "\n";
+    cout << "has cycle: " << (live.hasCycleUndirected() ? "yes" : "no");
+    live.addEdge(1, 0);
+    cout << ", after repeating edge 0-1: " << (live.hasCycleUndirected() ? "yes" : "no") << "\n";
+
+    cout << "\n-- Benchmark: incremental connectivity vs recomputing --\n";
+    benchmarkIncrementalConnectivity(1 << 20);
+
     return 0;
 }
\ No newline at end of file